@@ -6,6 +6,26 @@
 #include <tuple>
 #include <limits>
 #include <iostream>
+#include <array>
+#include <type_traits>
+#include <functional>
+#include <cstring>
+#include <cmath>
+#include <stdexcept>
+#ifdef TINYMP_PARALLEL
+#include <thread>
+#include <exception>
+#endif
+
+// operations of tinymp_fixed are constexpr only if std::array can be modified in constant expressions
+#if __cplusplus >= 201703L
+#define TINYMP_CONSTEXPR constexpr
+#else
+#define TINYMP_CONSTEXPR
+#endif
+
+template<std::size_t Bits> class tinymp_fixed;
+class tinymp_view;
 
 // tiny multi-precision integer class
 // distributed under the CC0-1.0
@@ -35,28 +55,16 @@ public:
 	tinymp(InIt it1, InIt it2): v(it1, it2), nonneg(true) {
 		if(v.size() == 0) v.push_back(0);
 	}
-	// not be smart but works in std
 	std::size_t hash() const noexcept {
-		std::vector<bool> t(v.size() * limits_type::digits);
-		auto it = t.begin();
-		for(auto val : v)
-			for(std::size_t i = 0; i < limits_type::digits; ++i)
-				*it++ = (val & (value_type(1) << i)) != 0;
-		return std::hash<decltype(t)>{}(t);
+		return hash_limbs(v.data(), v.size(), nonneg);
 	}
 
 	// compound assignments
 	tinymp& operator+=(const tinymp& other) {
-		if(nonneg ^ other.nonneg) nonneg ^= sub(v, other.v);
-		else add(v, other.v);
-		return *this;
+		return add_(other.v.data(), other.v.size(), other.nonneg);
 	}
 	tinymp& operator-=(const tinymp& other) {
-		if(!other.is_zero()) {
-			if(nonneg ^ other.nonneg) add(v, other.v);
-			else nonneg ^= sub(v, other.v);
-		}
-		return *this;
+		return other.is_zero() ? *this : add_(other.v.data(), other.v.size(), !other.nonneg);
 	}
 	tinymp& operator*=(value_type s) {
 		widen_type carry = 0;
@@ -76,8 +84,8 @@ public:
 		return *this;
 	}
 	tinymp& operator*=(const tinymp& other) {
-		*this = std::move(*this * other);
-		return *this;
+		if(&other == this) return *this *= tinymp(other);
+		return mul_(other.v.data(), other.v.size(), other.nonneg);
 	}
 	tinymp& operator/=(value_type s) {
 		return div_(s).first;
@@ -86,167 +94,464 @@ public:
 		return div_(other).first;
 	}
 	tinymp& operator%=(value_type s) {
-		*this = div_(s).second;
-		return *this;
+		return *this = tinymp(mod_ui(s), nonneg);
 	}
 	tinymp& operator%=(const tinymp& other) {
-		*this = div_(other).second;
+		if(&other == this) return *this = 0;
+		reduce_(*this, other, nullptr);
 		return *this;
 	}
-	// NOTE: shift by digits leads undefined behavior
-	tinymp& operator<<=(value_type s) {
+	// bit-wise operators act as infinite two's complement
+	tinymp& operator&=(const tinymp& other) {
+		return &other == this ? *this : bitwise_(other, std::bit_and<value_type>());
+	}
+	tinymp& operator|=(const tinymp& other) {
+		return &other == this ? *this : bitwise_(other, std::bit_or<value_type>());
+	}
+	tinymp& operator^=(const tinymp& other) {
+		return &other == this ? *this = 0 : bitwise_(other, std::bit_xor<value_type>());
+	}
+	// whole limbs move by insert, the remaining bits are funneled through widen_type without branches
+	tinymp& operator<<=(std::size_t s) {
+		if(is_zero()) return *this;
 		auto count = s / limits_type::digits;
 		auto bits = s % limits_type::digits;
-		value_type overflow = bits == 0 ? 0 : v[v.size() - 1] >> (limits_type::digits - bits);
-		v.resize(v.size() + count);
-		auto start = v.size();
-		if(overflow) v.push_back(overflow);
-		for(auto idx = start; idx > count + 1; --idx) {
-			v[idx - 1] = (v[idx - count - 1] << bits) | (bits ? (v[idx - count - 2] >> (limits_type::digits - bits)) : 0);
-		}
-		v[count] = v[0] << bits;
-		for(std::size_t idx = 0; idx < count; ++idx) v[idx] = 0;
+		if(bits == 0) { // v stays normalized with zero limbs inserted at the bottom
+			v.insert(v.begin(), count, 0);
+			return *this;
+		}
+		auto n = v.size();
+		v.resize(n + count + 1);
+		value_type *p = v.data();
+		p[n + count] = static_cast<value_type>(widen_type(p[n - 1]) >> (limits_type::digits - bits));
+		for(auto idx = n - 1; idx > 0; --idx)
+			p[idx + count] = static_cast<value_type>(((widen_type(p[idx]) << limits_type::digits) | p[idx - 1]) >> (limits_type::digits - bits));
+		p[count] = p[0] << bits;
+		std::fill(p, p + count, 0);
+		normalize();
 		return *this;
 	}
-	tinymp& operator>>=(value_type s) {
-		auto count = s / limits_type::digits;
-		auto bits = s % limits_type::digits;
-		if(count < v.size()) {
-			for(auto idx = 0; idx + count < v.size() - 1; ++idx) {
-				v[idx] = (v[idx + count] >> bits) | (bits ? (v[idx + count + 1] << (limits_type::digits - bits)) : 0);
-			}
-			v[v.size() - count - 1] = v[v.size() - 1] >> bits;
-			v.resize(v.size() - count);
-			normalize();
-		} else {
-			*this = 0;
+	// rounds toward negative infinity as arithmetic shift of two's complement
+	tinymp& operator>>=(std::size_t s) {
+		bool round = !nonneg && count_trailing_zeros() < s;
+		rshift_abs(s);
+		if(round) {
+			std::size_t idx = 0;
+			while(idx < v.size() && ++v[idx] == 0) ++idx;
+			if(idx == v.size()) v.push_back(1);
 		}
+		normalize();
 		return *this;
 	}
 	// arithmetic unary operators
-	tinymp operator+() const {
+	tinymp operator+() const & {
 		return tinymp(*this);
 	}
+	tinymp operator+() && {
+		return std::move(*this);
+	}
 	tinymp& flip_() noexcept {
 		if(v.size() != 1 || v[0] != 0) nonneg = !nonneg;
 		return *this;
 	}
-	tinymp operator-() const {
+	tinymp operator-() const & {
 		tinymp r(*this);
 		r.flip_();
 		return r; // NRVO
 	}
+	tinymp operator-() && {
+		flip_();
+		return std::move(*this);
+	}
+	// ~x == -x - 1
+	tinymp& not_() {
+		std::size_t idx = 0;
+		if(nonneg) { // -(|x| + 1)
+			while(idx < v.size() && ++v[idx] == 0) ++idx;
+			if(idx == v.size()) v.push_back(1);
+		} else { // |x| - 1
+			while(v[idx]-- == 0) ++idx;
+		}
+		nonneg = !nonneg;
+		normalize();
+		return *this;
+	}
+	tinymp operator~() const & {
+		tinymp r(*this);
+		r.not_();
+		return r; // NRVO
+	}
+	tinymp operator~() && {
+		not_();
+		return std::move(*this);
+	}
 	// arithmetic binary operator helper
 	std::pair<tinymp&, tinymp> div_(value_type s) {
 		widen_type unit = widen_type(1) << limits_type::digits;
 		widen_type borrow = 0;
+		const bool sign = nonneg; // normalize() makes a zero quotient non-negative
 		for(std::size_t i = 0; i < v.size(); ++i) {
 			auto temp = borrow * unit + v[v.size() - i - 1];
 			v[v.size() - i - 1] = temp / s;
 			borrow = temp % s;
 		}
 		normalize();
-		return { std::piecewise_construct, std::forward_as_tuple(*this), std::forward_as_tuple(borrow, nonneg) };
+		return { std::piecewise_construct, std::forward_as_tuple(*this), std::forward_as_tuple(borrow, sign) };
 	}
 	std::pair<tinymp, tinymp> div(value_type s) const {
 		return tinymp(*this).div_(s);
 	}
 	std::pair<tinymp&, tinymp> div_(const tinymp& other) {
-		auto t = tinymp(*this).div(other);
+		auto t = &other == this ? div(other) : div_imp(std::move(*this), other);
 		*this = std::move(t.first);
 		return { std::piecewise_construct, std::forward_as_tuple(*this), std::forward_as_tuple(std::move(t.second)) };
 	}
 	std::pair<tinymp, tinymp> div(const tinymp& other) const {
-		// TODO: check Knuth algorithm
-		std::pair<tinymp, tinymp> p{ std::piecewise_construct, std::forward_as_tuple(), std::forward_as_tuple(*this) };
-		if(!(absless(other))) {
-			tinymp& r = p.first;
-			r.v.resize(v.size() - other.v.size() + 1);
-			tinymp & residual = p.second;
-			residual.nonneg = true;
-			for(std::size_t i = 0; i < r.v.size(); ++i) {
-				std::size_t idxr = r.v.size() - i - 1;
-				if(residual.v.size() < idxr + other.v.size() || absless(residual.v, coffseter_type(other.v, idxr))) continue;
-				widen_type res = 0;
-				if(residual.v.size() > idxr + other.v.size()) {
-					res = widen_type(residual.v[idxr + other.v.size()]) << limits_type::digits;
-				}
-				res += residual.v[idxr + other.v.size() - 1];
-				widen_type top = other.v.back();
-				if(2 <= idxr + other.v.size() && other.v.size() >= 2) {
-					auto bres = wlimits_type::digits;
-					while(bres > 0 && !((widen_type(1) << (bres-1)) & res)) --bres;
-					auto btop = wlimits_type::digits;
-					while(btop > 0 && !((widen_type(1) << (btop-1)) & top)) --btop;
-					auto bits = std::min<std::size_t>(32, wlimits_type::digits - std::max(bres, btop));
-					if(bits) {
-						res <<= bits;
-						res += residual.v[idxr + other.v.size() - 2] >> (limits_type::digits - bits);
-						top <<= bits;
-						top += other.v[other.v.size() - 2] >> (limits_type::digits - bits);
-					}
-				}
-				widen_type candidate = res / top; // candidate may exceed limits_type::max()
-				--candidate; // res >= top if !absless(residual.v, coffseter_type(other.v, idxr))
-				candidate = std::min<widen_type>(candidate, limits_type::max());
-				auto temp = other * candidate;
-				while(candidate == 0 || !absless(residual.v, offseter_type(temp.v, idxr))) {
-					++candidate;
-					temp += other; // temp = other * candidate seems to be faster if other has 1000 digits (base-10) order
-				}
-				--candidate;
-				temp -= other; // temp = other * candidate seems to be faster if other has 1000 digits (base-10) order
-				sub(residual.v, offseter_type(temp.v, idxr)); // residual -= (temp << (idxr * BITS));
-				r.v[idxr] = candidate;
-			}
-			r.normalize();
-			r.nonneg = !(nonneg ^ other.nonneg);
-			if(!nonneg) residual.flip_();
-		}
-		return p;
+		return div_imp(tinymp(*this), other);
 	}
 #ifdef TINYMP_KARATSUBA
 	tinymp mult(const tinymp& other) const {
 		return mult(*this, other);
 	}
+#endif
+#ifdef TINYMP_PARALLEL
+	// the longer operand is cut into slices multiplied by the shorter one concurrently, then partial products are summed up
+	friend inline tinymp mul_parallel(const tinymp &v1, const tinymp &v2, unsigned threads = std::thread::hardware_concurrency()) {
+		const tinymp &l = v1.v.size() < v2.v.size() ? v2 : v1;
+		const tinymp &s = v1.v.size() < v2.v.size() ? v1 : v2;
+		const std::size_t min_slice = 256; // in limbs, smaller slices do not pay for a thread
+		const std::size_t slices = std::min<std::size_t>(threads, l.v.size() / min_slice);
+		if(slices < 2 || s.v.size() < min_slice / 8) return v1 * v2;
+		std::vector<tinymp> partial(slices);
+		parallel_chunks(l.v.size(), slices, [&](std::size_t i, std::size_t first, std::size_t last) {
+			tinymp t(l.v.begin() + first, l.v.begin() + last);
+			t.normalize();
+			partial[i] = std::move(t *= s);
+		});
+		tinymp r;
+		r.v.assign(l.v.size() + s.v.size(), 0);
+		for(std::size_t i = 0; i < slices; ++i) { // magnitudes only, the signs are settled at last
+			const auto &p = partial[i].v;
+			value_type *q = r.v.data() + chunk_first(i, l.v.size(), slices);
+			value_type carry = add_n(q, q, p.data(), p.size());
+			for(auto idx = p.size(); carry != 0; ++idx) carry = ++q[idx] == 0;
+		}
+		r.normalize();
+		r.nonneg = r.is_zero() || v1.nonneg == v2.nonneg;
+		return r; // NRVO
+	}
+	// batch operations, values are split into contiguous chunks for threads and partial results are combined pairwise
+	friend inline tinymp parallel_sum(const std::vector<tinymp> &vals, unsigned threads = std::thread::hardware_concurrency()) {
+		const std::size_t chunks = std::max<std::size_t>(1, std::min<std::size_t>(threads, vals.size()));
+		std::vector<tinymp> partial(chunks);
+		parallel_chunks(vals.size(), chunks, [&](std::size_t i, std::size_t first, std::size_t last) {
+			for(auto idx = first; idx < last; ++idx) partial[i] += vals[idx];
+		});
+		for(std::size_t step = 1; step < chunks; step *= 2) {
+			for(std::size_t i = 0; i + step < chunks; i += 2 * step) partial[i] += partial[i + step];
+		}
+		return std::move(partial[0]);
+	}
+	friend inline tinymp parallel_product(const std::vector<tinymp> &vals, unsigned threads = std::thread::hardware_concurrency()) {
+		const std::size_t chunks = std::max<std::size_t>(1, std::min<std::size_t>(threads, vals.size()));
+		std::vector<tinymp> partial(chunks, 1);
+		parallel_chunks(vals.size(), chunks, [&](std::size_t i, std::size_t first, std::size_t last) {
+			partial[i] = product_tree(vals.data() + first, last - first);
+		});
+		// the last levels have few but large products, they get all threads in turn
+		for(std::size_t step = 1; step < chunks; step *= 2) {
+			for(std::size_t i = 0; i + step < chunks; i += 2 * step) partial[i] = mul_parallel(partial[i], partial[i + step], threads);
+		}
+		return std::move(partial[0]);
+	}
+	template<typename F> // F: tinymp(const tinymp&)
+	friend inline std::vector<tinymp> parallel_transform(const std::vector<tinymp> &vals, F f, unsigned threads = std::thread::hardware_concurrency()) {
+		std::vector<tinymp> r(vals.size());
+		parallel_chunks(vals.size(), threads, [&](std::size_t, std::size_t first, std::size_t last) {
+			for(auto idx = first; idx < last; ++idx) r[idx] = f(vals[idx]);
+		});
+		return r; // NRVO
+	}
+	friend inline std::vector<tinymp> parallel_mod(const std::vector<tinymp> &vals, const tinymp &d, unsigned threads = std::thread::hardware_concurrency()) {
+		return parallel_transform(vals, [&d](const tinymp &val) { return mod(val, d); }, threads);
+	}
 #endif
 	// arithmetic binary operators
+	// rvalue overloads reuse storage of a dying operand
 	friend inline tinymp operator+(const tinymp &v1, const tinymp &v2) {
 		tinymp r(v1); r += v2; return r; // NRVO
 	}
+	friend inline tinymp operator+(tinymp &&v1, const tinymp &v2) {
+		v1 += v2; return std::move(v1);
+	}
+	friend inline tinymp operator+(const tinymp &v1, tinymp &&v2) {
+		v2 += v1; return std::move(v2);
+	}
+	friend inline tinymp operator+(tinymp &&v1, tinymp &&v2) {
+		v1 += v2; return std::move(v1);
+	}
 	friend inline tinymp operator-(const tinymp &v1, const tinymp &v2) {
 		tinymp r(v1); r -= v2; return r; // NRVO
 	}
+	friend inline tinymp operator-(tinymp &&v1, const tinymp &v2) {
+		v1 -= v2; return std::move(v1);
+	}
+	friend inline tinymp operator-(const tinymp &v1, tinymp &&v2) {
+		v2 -= v1; v2.flip_(); return std::move(v2);
+	}
+	friend inline tinymp operator-(tinymp &&v1, tinymp &&v2) {
+		v1 -= v2; return std::move(v1);
+	}
 	friend inline tinymp operator*(const tinymp &v, value_type s) {
 		tinymp r(v); r *= s; return r; // NRVO
 	}
+	friend inline tinymp operator*(tinymp &&v, value_type s) {
+		v *= s; return std::move(v);
+	}
 	friend tinymp operator*(const tinymp &v1, const tinymp& v2) {
 		tinymp r;
-		vector_type tempv(2);
-		r.v.resize(v1.v.size() + v2.v.size());
-		for(std::size_t i = 0; i < v1.v.size(); ++i) {
-			for(std::size_t j = 0; j < v2.v.size(); ++j) {
-				widen_type temp = widen_type(v1.v[i]) * v2.v[j];
-				tempv[0] = temp;
-				tempv[1] = temp >> limits_type::digits;
-				add(r.v, offseter_type(tempv, i+j));
-			}
-		}
-		r.normalize();
-		r.nonneg = !(v1.nonneg ^ v2.nonneg);
+		r.v.reserve(v1.v.size() + v2.v.size());
+		r.v = v1.v;
+		r.nonneg = v1.nonneg;
+		r *= v2;
 		return r; // NRVO
 	}
+	friend inline tinymp operator*(tinymp &&v1, const tinymp &v2) {
+		v1 *= v2; return std::move(v1);
+	}
+	friend inline tinymp operator*(const tinymp &v1, tinymp &&v2) {
+		v2 *= v1; return std::move(v2);
+	}
+	friend inline tinymp operator*(tinymp &&v1, tinymp &&v2) {
+		v1 *= v2; return std::move(v1);
+	}
 	friend inline tinymp operator/(const tinymp &v, value_type s) {
 		tinymp r(v); r /= s; return r; // NRVO
 	}
+	friend inline tinymp operator/(tinymp &&v, value_type s) {
+		v /= s; return std::move(v);
+	}
 	friend inline tinymp operator/(const tinymp &v1, const tinymp &v2) {
 		tinymp r(v1); r /= v2; return r; // NRVO
 	}
+	friend inline tinymp operator/(tinymp &&v1, const tinymp &v2) {
+		v1 /= v2; return std::move(v1);
+	}
 	friend inline tinymp operator%(const tinymp &v, value_type s) {
-		return tinymp(v).div_(s).second;
+		return tinymp(v.mod_ui(s), v.nonneg);
+	}
+	friend inline tinymp operator%(tinymp &&v, value_type s) {
+		v %= s; return std::move(v);
 	}
 	friend inline tinymp operator%(const tinymp &v1, const tinymp &v2) {
-		return tinymp(v1).div_(v2).second;
+		return mod(v1, v2);
+	}
+	friend inline tinymp operator%(tinymp &&v1, const tinymp &v2) {
+		v1 %= v2; return std::move(v1);
+	}
+	// remainder without quotient, the sign follows the dividend as operator%
+	friend inline tinymp mod(const tinymp &v1, const tinymp &v2) {
+		if(v1.absless(v2)) return v1;
+		tinymp r(v1);
+		reduce_(r, v2, nullptr);
+		return r; // NRVO
+	}
+	// |*this| % d without writing back, d should be non-zero
+	value_type mod_ui(value_type d) const noexcept {
+		widen_type r = 0;
+		for(std::size_t i = v.size(); i > 0; --i) r = ((r << limits_type::digits) | v[i - 1]) % d;
+		return static_cast<value_type>(r);
+	}
+	// divisibility without quotient, only 0 is divisible by 0
+	bool is_divisible_by(value_type d) const noexcept {
+		return d == 0 ? is_zero() : mod_ui(d) == 0;
+	}
+	bool is_divisible_by(const tinymp &d) const {
+		if(d.is_zero()) return is_zero();
+		if(d.v.size() == 1) return mod_ui(d.v[0]) == 0;
+		if(absless(d)) return is_zero();
+		if(count_trailing_zeros() < d.count_trailing_zeros()) return false;
+		tinymp r(*this);
+		reduce_(r, d, nullptr);
+		return r.is_zero();
+	}
+	// fused multiply-accumulate: acc += a * b (addmul), acc -= a * b (submul) without product temporary
+	friend inline tinymp& addmul(tinymp &acc, const tinymp &a, const tinymp &b) {
+		if(&acc == &a || &acc == &b) return acc += a * b;
+		return acc.addmul_imp(a.v.data(), a.v.size(), b.v, !(a.nonneg ^ b.nonneg));
+	}
+	friend inline tinymp& submul(tinymp &acc, const tinymp &a, const tinymp &b) {
+		if(&acc == &a || &acc == &b) return acc -= a * b;
+		return acc.addmul_imp(a.v.data(), a.v.size(), b.v, a.nonneg ^ b.nonneg);
+	}
+	friend inline tinymp& addmul_ui(tinymp &acc, const tinymp &a, value_type s) {
+		if(&acc == &a) return acc += a * s;
+		return acc.addmul_imp(&s, 1, a.v, a.nonneg);
+	}
+	friend inline tinymp& submul_ui(tinymp &acc, const tinymp &a, value_type s) {
+		if(&acc == &a) return acc -= a * s;
+		return acc.addmul_imp(&s, 1, a.v, !a.nonneg);
+	}
+	// roots by Newton iteration with precision doubling
+	friend inline tinymp isqrt(const tinymp &v) { // v should be non-negative
+		return iroot_abs(v, 2);
+	}
+	friend inline std::pair<tinymp, tinymp> sqrtrem(const tinymp &v) { // { isqrt(v), v - isqrt(v)^2 }
+		std::pair<tinymp, tinymp> p{ isqrt(v), v };
+		submul(p.second, p.first, p.first);
+		return p; // NRVO
+	}
+	friend inline tinymp iroot(const tinymp &v, value_type k) { // truncated toward zero, v should be non-negative for even k
+		if(k == 0) throw std::domain_error("zeroth root");
+		tinymp r = iroot_abs(v, k);
+		if(!v.nonneg) r.flip_();
+		return r; // NRVO
+	}
+	friend inline tinymp divexact(const tinymp &a, const tinymp &d) { // a should be a multiple of d, d should be non-zero
+		if(a.is_zero()) return a;
+		// a / d == (a >> tz) / (d >> tz) for the trailing zeros tz of d, then the divisor is odd
+		auto tz = d.count_trailing_zeros();
+		tinymp q(a), odd;
+		q.rshift_abs(tz);
+		q.normalize();
+		const tinymp *pd = &d;
+		if(tz) {
+			odd = d;
+			odd.rshift_abs(tz);
+			odd.normalize();
+			pd = &odd;
+		}
+		cvector_type &dv = pd->v;
+		// Jebelean: quotient limbs from the bottom, each is the remainder limb times d^-1 mod 2^32
+		std::size_t qn = q.v.size() - dv.size() + 1;
+		q.v.resize(qn);
+		value_type inv = dv[0]; // correct to 3 bits since d * d == 1 mod 8 for odd d
+		for(int i = 0; i < 4; ++i) inv *= 2 - dv[0] * inv;
+		for(std::size_t i = 0; i < qn; ++i) {
+			value_type qi = q.v[i] * inv;
+			q.v[i] = qi;
+			// subtract qi * d from the rest, the lowest limb cancels exactly and limbs above qn are not needed
+			widen_type borrow = (widen_type(qi) * dv[0]) >> limits_type::digits;
+			for(std::size_t j = 1; i + j < qn && (j < dv.size() || borrow != 0); ++j) {
+				widen_type temp = (j < dv.size() ? widen_type(dv[j]) * qi : 0) + borrow;
+				value_type low = temp;
+				borrow = (temp >> limits_type::digits) + (q.v[i + j] < low);
+				q.v[i + j] -= low;
+			}
+		}
+		q.nonneg = a.nonneg == d.nonneg;
+		q.normalize();
+		return q; // NRVO
+	}
+	friend inline tinymp pow(const tinymp &base, std::uint64_t e) { // base^e, 1 for e == 0
+		if(e == 0) return 1;
+		if(base.is_zero()) return base;
+		// base = odd * 2^tz, then base^e = odd^e * 2^(tz * e)
+		auto tz = base.count_trailing_zeros();
+		tinymp odd(base);
+		odd.rshift_abs(tz);
+		odd.normalize();
+		tinymp r(odd);
+		if(odd.v.size() != 1 || odd.v[0] != 1) { // left-to-right binary exponentiation
+			int bit = 63;
+			while(!((e >> bit) & 1)) --bit;
+			while(--bit >= 0) {
+				r *= r;
+				if((e >> bit) & 1) r *= odd;
+			}
+		} else if(!(e & 1)) r.nonneg = true;
+		r <<= tz * e;
+		return r; // NRVO
+	}
+	// perfect power detection, quadratic/cubic/quintic residues modulo small numbers reject most candidates before any root
+	friend inline bool is_square(const tinymp &v) {
+		if(!v.nonneg || !maybe_power(2, v.v[0] & 63, v.mod_ui(45045))) return false;
+		tinymp r = isqrt(v);
+		return r * r == v;
+	}
+	friend inline bool is_perfect_power(const tinymp &v) { // 0, 1 and -1 are perfect powers
+		if(v.v.size() == 1 && v.v[0] <= 1) return true;
+		const auto b = v.bit_length();
+		const auto tz = v.count_trailing_zeros();
+		const auto r = v.mod_ui(45045);
+		for(value_type p = v.nonneg ? 2 : 3; p < b; ++p) { // p < b keeps the root at least 2
+			if(!is_prime_ui(p) || tz % p != 0 || !maybe_power(p, v.v[0] & 63, r) || !maybe_power_mod(v, p)) continue;
+			tinymp root = iroot(v, p);
+			if(powmod_2_32(root.v[0], p) != v.v[0]) continue; // the lowest limb of |root|^p first
+			if(pow(root, p) == v) return true;
+		}
+		return false;
+	}
+	// Baillie-PSW: trial division, strong probable prime test to base 2 and strong Lucas test with Selfridge's parameters
+	// rounds adds Miller-Rabin tests to the bases of successive odd primes, sign is ignored
+	friend inline bool is_probable_prime(const tinymp &v, std::size_t rounds = 0) {
+		const auto &primes = small_primes();
+		if(v.v.size() == 1 && v.v[0] < 65536) { // 251 is the largest prime below 256
+			value_type x = v.v[0];
+			if(x < 4) return x >= 2;
+			if(x % 2 == 0) return false;
+			for(std::size_t i = 0; i < primes.size() && primes[i] * primes[i] <= x; ++i) if(x % primes[i] == 0) return false;
+			return true;
+		}
+		if(!v.test_bit(0)) return false;
+		bool divisible = false;
+		for_small_prime_divisors(v, [&](value_type) { divisible = true; return false; });
+		if(divisible) return false;
+		tinymp n(v);
+		n.nonneg = true;
+		montgomery mont(n);
+		if(!strong_probable_prime(n, mont, 2)) return false;
+		if(!strong_lucas_probable_prime(n, mont)) return false;
+		for(std::size_t i = 0; i < rounds && i < primes.size(); ++i) if(!strong_probable_prime(n, mont, primes[i])) return false;
+		return true;
+	}
+	// binary GCD, always non-negative
+	friend inline tinymp gcd(const tinymp &v1, const tinymp &v2) {
+		tinymp a(v1), b(v2);
+		a.nonneg = b.nonneg = true;
+		if(a.is_zero()) return b;
+		if(b.is_zero()) return a;
+		auto za = a.count_trailing_zeros(), zb = b.count_trailing_zeros();
+		a >>= za;
+		b >>= zb;
+		while(true) { // both odd
+			if(b.absless(a)) std::swap(a, b);
+			sub(b.v, a.v);
+			if(b.is_zero()) return a <<= std::min(za, zb);
+			b >>= b.count_trailing_zeros();
+		}
+	}
+	// prime factors of |v| in ascending order with multiplicity by trial division and Pollard-Brent rho, empty for 0 and 1
+	friend inline std::vector<tinymp> factor(const tinymp &v) {
+		std::vector<tinymp> r;
+		tinymp n(v);
+		n.nonneg = true;
+		if(n.is_zero()) return r;
+		auto tz = n.count_trailing_zeros();
+		r.assign(tz, tinymp(2));
+		n >>= tz;
+		for_small_prime_divisors(n, [&](value_type p) {
+			while(n.mod_ui(p) == 0) {
+				r.push_back(p);
+				n.div_(p);
+			}
+			return true;
+		});
+		std::vector<tinymp> stack;
+		if(n != 1) stack.push_back(std::move(n));
+		while(!stack.empty()) {
+			tinymp t = std::move(stack.back());
+			stack.pop_back();
+			if(is_probable_prime(t)) {
+				r.push_back(std::move(t));
+			} else {
+				tinymp d = pollard_brent(t);
+				stack.push_back(t / d);
+				stack.push_back(std::move(d));
+			}
+		}
+		std::sort(r.begin(), r.end());
+		return r; // NRVO
 	}
 	// increment/decrement operators
 	tinymp& operator++() { *this += 1; return *this; }
@@ -254,9 +559,84 @@ public:
 	tinymp& operator--() { *this -= 1; return *this; }
 	tinymp operator--(int) { tinymp t(*this); *this -= 1; return t; } // NRVO
 	// shift operators
-	tinymp operator<<(std::size_t s) const { tinymp r(*this); r <<= s; return r; } // NRVO
-	tinymp operator>>(std::size_t s) const { tinymp r(*this); r >>= s; return r; } // NRVO
-	// TODO: bit-wise arithmetic
+	tinymp operator<<(std::size_t s) const & { tinymp r(*this); r <<= s; return r; } // NRVO
+	tinymp operator<<(std::size_t s) && { *this <<= s; return std::move(*this); }
+	tinymp operator>>(std::size_t s) const & { tinymp r(*this); r >>= s; return r; } // NRVO
+	tinymp operator>>(std::size_t s) && { *this >>= s; return std::move(*this); }
+	// shift by power of 2 in GMP manner: fdiv rounds toward negative infinity, tdiv truncates toward zero
+	friend inline tinymp mul_2exp(const tinymp &v, std::size_t s) { return v << s; }
+	friend inline tinymp fdiv_q_2exp(const tinymp &v, std::size_t s) { return v >> s; }
+	friend inline tinymp tdiv_q_2exp(const tinymp &v, std::size_t s) {
+		tinymp r(v); r.rshift_abs(s); r.normalize(); return r; // NRVO
+	}
+	friend inline tinymp tdiv_r_2exp(const tinymp &v, std::size_t s) { // sign of v and the lowest s bits of |v|
+		tinymp r(v);
+		auto count = s / limits_type::digits;
+		if(count < r.v.size()) {
+			r.v.resize(count + 1);
+			r.v[count] &= (value_type(1) << (s % limits_type::digits)) - 1;
+		}
+		r.normalize();
+		return r; // NRVO
+	}
+	// bit inspection
+	std::size_t bit_length() const noexcept { // of absolute value, 0 for 0
+		return v.size() * limits_type::digits - clz(v.back());
+	}
+	std::size_t popcount() const noexcept { // of absolute value
+		std::size_t r = 0;
+		for(auto val : v) r += popcount(val);
+		return r;
+	}
+	std::size_t count_trailing_zeros() const noexcept { // 0 for 0
+		std::size_t idx = 0;
+		while(idx + 1 < v.size() && v[idx] == 0) ++idx;
+		return idx * limits_type::digits + (v[idx] ? ctz(v[idx]) : 0);
+	}
+	bool test_bit(std::size_t n) const noexcept { // as infinite two's complement for negative values
+		std::size_t idx = n / limits_type::digits;
+		bool bit = idx < v.size() && ((v[idx] >> (n % limits_type::digits)) & 1);
+		if(nonneg) return bit;
+		auto tz = count_trailing_zeros();
+		return n <= tz ? n == tz : !bit;
+	}
+	// bit-wise binary operators
+	friend inline tinymp operator&(const tinymp &v1, const tinymp &v2) {
+		tinymp r(v1); r &= v2; return r; // NRVO
+	}
+	friend inline tinymp operator&(tinymp &&v1, const tinymp &v2) {
+		v1 &= v2; return std::move(v1);
+	}
+	friend inline tinymp operator&(const tinymp &v1, tinymp &&v2) {
+		v2 &= v1; return std::move(v2);
+	}
+	friend inline tinymp operator&(tinymp &&v1, tinymp &&v2) {
+		v1 &= v2; return std::move(v1);
+	}
+	friend inline tinymp operator|(const tinymp &v1, const tinymp &v2) {
+		tinymp r(v1); r |= v2; return r; // NRVO
+	}
+	friend inline tinymp operator|(tinymp &&v1, const tinymp &v2) {
+		v1 |= v2; return std::move(v1);
+	}
+	friend inline tinymp operator|(const tinymp &v1, tinymp &&v2) {
+		v2 |= v1; return std::move(v2);
+	}
+	friend inline tinymp operator|(tinymp &&v1, tinymp &&v2) {
+		v1 |= v2; return std::move(v1);
+	}
+	friend inline tinymp operator^(const tinymp &v1, const tinymp &v2) {
+		tinymp r(v1); r ^= v2; return r; // NRVO
+	}
+	friend inline tinymp operator^(tinymp &&v1, const tinymp &v2) {
+		v1 ^= v2; return std::move(v1);
+	}
+	friend inline tinymp operator^(const tinymp &v1, tinymp &&v2) {
+		v2 ^= v1; return std::move(v2);
+	}
+	friend inline tinymp operator^(tinymp &&v1, tinymp &&v2) {
+		v1 ^= v2; return std::move(v1);
+	}
 	// comparison
 	bool absless(const tinymp &other) const noexcept {
 		return absless(v, other.v);
@@ -290,44 +670,246 @@ public:
 	friend inline bool operator>=(const tinymp &v1, const tinymp &v2) noexcept {
 		return !(v2 > v1);
 	}
-	// literal
+	// product of [first, last) by multiplying the two shortest operands first, as Huffman coding merges weights
+	template<typename InIt>
+	static tinymp product(InIt first, InIt last) {
+		std::vector<tinymp> heap(first, last);
+		if(heap.empty()) return 1;
+		auto longer = [](const tinymp &a, const tinymp &b) { return a.v.size() > b.v.size(); }; // min-heap by limb count
+		std::make_heap(heap.begin(), heap.end(), longer);
+		while(heap.size() > 1) {
+			std::pop_heap(heap.begin(), heap.end(), longer);
+			tinymp t = std::move(heap.back());
+			heap.pop_back();
+			std::pop_heap(heap.begin(), heap.end(), longer);
+			heap.back() *= t;
+			std::push_heap(heap.begin(), heap.end(), longer);
+		}
+		return std::move(heap.front());
+	}
+	// combinatorial functions multiplying prime powers with balanced product trees
+	static inline tinymp factorial(value_type n) { // n! = ((n/2)!)^2 * swing(n) by Luschny's prime swing
+		if(n < 2) return 1;
+		tinymp r = factorial(n / 2);
+		r *= tinymp(r);
+		vector_type factors;
+		for(auto p : primes_upto(n)) {
+			value_type f = 1;
+			for(value_type q = n / p; q > 0; q /= p) if(q & 1) f *= p;
+			if(f > 1) factors.push_back(f);
+		}
+		return r *= product_tree(factors.data(), factors.size());
+	}
+	static inline tinymp binomial(value_type n, value_type k) { // exponents of primes by Legendre's formula, 0 for k > n
+		if(k > n) return 0;
+		vector_type factors;
+		for(auto p : primes_upto(n)) {
+			value_type f = 1;
+			for(widen_type q = p; q <= n; q *= p) {
+				if(n / q - k / q - (n - k) / q) f *= p;
+			}
+			if(f > 1) factors.push_back(f);
+		}
+		return product_tree(factors.data(), factors.size()); // RVO
+	}
+	static inline tinymp primorial(value_type n) { // product of primes <= n
+		vector_type primes = primes_upto(n);
+		return product_tree(primes.data(), primes.size()); // RVO
+	}
+	// literal, digits are converted to limbs at compile time unless too long for template recursion
 	template<char ... c>
 	static inline tinymp literal()
 	{
-		std::string s({c...});
-		return tinymp(s.data(), s.size(), 0); // RVO
+		return literal_<c...>(std::integral_constant<bool, sizeof...(c) <= lit_max_chars>()); // RVO
 	}
 	// I/O
 	static inline tinymp stotmp(const std::string &s, int base = 10) {
 		return tinymp(s.data(), s.size(), base); // RVO
 	}
+	// digits are parsed straight from the stream buffer and the limbs of the destination are reused
 	friend inline std::istream& operator>>(std::istream &is, tinymp& v) {
-		std::string s;
-		is >> s;
-		int base = (is.flags() & std::ios_base::oct) ? 8 : (is.flags() & std::ios_base::hex) ? 16 : 10;
-		v.from_chars(s.data(), s.size(), base);
+		return v.extract_(is);
+	}
+	friend inline std::istream& read_many(std::istream &is, std::vector<tinymp> &vals) { // fills all elements in order
+		for(auto &val : vals) if(!val.extract_(is)) break;
 		return is;
 	}
-	friend inline std::string to_string(tinymp v, int base = 10, bool upper = false) {
-		std::string s;
-		bool negative = !v.nonneg;
-		if(v.is_zero()) s = "0";
-		else {
-			if(negative) s = "-";
-			while(!v.is_zero()) { auto t = v.div_(base); s.push_back(t.second.v[0] + (t.second.v[0] >= 10 ? (upper ? 'A' : 'a') - 10 : '0')); }
-			std::reverse(s.begin() + (negative ? 1 : 0), s.end());
-		}
+	// upper bound of to_chars() output length by bit_length(), including the sign
+	std::size_t chars_bound(int base = 10) const noexcept {
+		const double digits_per_bit = std::log(2.0) / std::log(static_cast<double>(base));
+		return static_cast<std::size_t>(bit_length() * digits_per_bit) + 2 + (nonneg ? 0 : 1);
+	}
+	// writes v into [first, last) without terminator, returns the end or nullptr if it does not fit
+	friend inline char* to_chars(char *first, char *last, const tinymp &v, int base = 10, bool upper = false) {
+		if(first == last) return nullptr;
+		if(!v.nonneg) *first++ = '-';
+		// digits from the lowest, a chunk of k digits at a time by dividing by base^k in a limb
+		value_type chunk_scale = base;
+		std::size_t k = 1;
+		for(; chunk_scale <= limits_type::max() / base; ++k) chunk_scale *= base;
+		vector_type w(v.v);
+		char *p = first;
+		do {
+			widen_type r = 0;
+			for(std::size_t i = w.size(); i > 0; --i) {
+				widen_type temp = (r << limits_type::digits) | w[i - 1];
+				w[i - 1] = static_cast<value_type>(temp / chunk_scale);
+				r = temp % chunk_scale;
+			}
+			while(w.size() > 1 && w.back() == 0) w.pop_back();
+			const bool top = w.size() == 1 && w[0] == 0;
+			for(std::size_t i = 0; i < k && (!top || r != 0 || p == first); ++i) {
+				if(p == last) return nullptr;
+				auto d = static_cast<char>(r % base);
+				*p++ = d + (d >= 10 ? (upper ? 'A' : 'a') - 10 : '0');
+				r /= base;
+			}
+			if(top) break;
+		} while(true);
+		std::reverse(first, p);
+		return p;
+	}
+	friend inline std::string to_string(const tinymp &v, int base = 10, bool upper = false) {
+		std::string s(v.chars_bound(base), '\0');
+		s.resize(to_chars(&s[0], &s[0] + s.size(), v, base, upper) - &s[0]);
 		return s; // NRVO
 	}
 	friend inline std::ostream& operator<<(std::ostream &os, const tinymp& v) {
 		int base = (os.flags() & std::ios_base::oct) ? 8 : (os.flags() & std::ios_base::hex) ? 16 : 10;
 		bool upper = (os.flags() & std::ios_base::uppercase) != 0;
-		return os << to_string(v, base, upper);
+		char buf[256];
+		const auto n = v.chars_bound(base);
+		if(n <= sizeof(buf)) return put_padded(os, buf, to_chars(buf, buf + n, v, base, upper));
+		std::vector<char> big(n);
+		return put_padded(os, big.data(), to_chars(big.data(), big.data() + n, v, base, upper));
+	}
+	// binary format: LEB128 varint of (limb count << 1 | negative), then limbs from the lowest in little endian
+	// zero is the single byte 0, limbs are copied as they are on little endian hosts
+	std::size_t serialized_size() const noexcept {
+		std::size_t r = 1;
+		for(auto h = header(); h > 0x7F; h >>= 7) ++r;
+		return r + (is_zero() ? 0 : v.size() * sizeof(value_type));
+	}
+	char* serialize(char *p) const noexcept { // writes serialized_size() bytes and returns the end
+		p = put_varint(p, header());
+		return is_zero() ? p : put_limbs(p, v.data(), v.size());
+	}
+	std::string serialize() const {
+		std::string s(serialized_size(), '\0');
+		serialize(&s[0]);
+		return s; // NRVO
+	}
+	std::ostream& serialize(std::ostream &os) const {
+		char buf[10]; // 64-bit varint at most
+		os.write(buf, put_varint(buf, header()) - buf);
+		if(is_zero()) return os;
+		if(little_endian()) return os.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(value_type));
+		std::string s(v.size() * sizeof(value_type), '\0');
+		put_limbs(&s[0], v.data(), v.size());
+		return os.write(s.data(), s.size());
+	}
+	const char* deserialize(const char *first, const char *last) { // returns the end of consumed bytes, nullptr if truncated or malformed
+		widen_type h = 0;
+		for(int shift = 0, more = 1; more; shift += 7) {
+			if(first == last) return nullptr;
+			more = get_varint(h, shift, static_cast<unsigned char>(*first++));
+			if(more < 0) return nullptr;
+		}
+		if(static_cast<widen_type>(last - first) / sizeof(value_type) < (h >> 1)) return nullptr;
+		const std::size_t n = h >> 1;
+		if(n) {
+			value_type top;
+			get_limbs(&top, first + (n - 1) * sizeof(value_type), 1);
+			if(top == 0) return nullptr; // non-canonical
+		}
+		from_header(h);
+		if(n) get_limbs(v.data(), first, n);
+		return first + n * sizeof(value_type);
+	}
+	std::istream& deserialize(std::istream &is) { // failbit is set and the value is zero if truncated or malformed
+		*this = 0;
+		widen_type h = 0;
+		for(int shift = 0, more = 1; more; shift += 7) {
+			auto c = is.get();
+			if(!is) return is;
+			more = get_varint(h, shift, static_cast<unsigned char>(c));
+			if(more < 0) { is.setstate(std::ios_base::failbit); return is; }
+		}
+		const widen_type n = h >> 1;
+		if(n == 0) return is;
+		vector_type w;
+		std::string s;
+		for(widen_type i = 0; i < n; ) { // grows with the data read, never by the count in the header alone
+			const std::size_t m = static_cast<std::size_t>(std::min<widen_type>(n - i, 1 << 16));
+			w.resize(static_cast<std::size_t>(i) + m);
+			char *p = reinterpret_cast<char*>(w.data() + i);
+			if(!little_endian()) { s.resize(m * sizeof(value_type)); p = &s[0]; }
+			if(!is.read(p, m * sizeof(value_type))) return is;
+			if(!little_endian()) get_limbs(w.data() + i, s.data(), m);
+			i += m;
+		}
+		if(w.back() == 0) { is.setstate(std::ios_base::failbit); return is; } // non-canonical
+		v.swap(w);
+		nonneg = !(h & 1);
+		return is;
 	}
 
 private:
+	template<std::size_t Bits> friend class tinymp_fixed;
+	friend class tinymp_view;
 	vector_type v;
 	bool nonneg;
+
+	// compile-time literal conversion
+	static constexpr std::size_t lit_max_chars = 200; // recursion depth and compile time grow with the digit count
+	template<char ... c>
+	static tinymp literal_(std::true_type) {
+		return lit_base<c...>::type::make(); // RVO
+	}
+	template<char ... c>
+	static tinymp literal_(std::false_type) { // parsed at run time, digit separators are skipped
+		static const char s[] = { c... };
+		return tinymp(s, sizeof(s), 0); // RVO
+	}
+	template<value_type ... L> // limbs from the lowest
+	struct lit_limbs {
+		static tinymp make() {
+			static const value_type data[] = { L..., 0 }; // trailing 0 for an empty pack
+			return tinymp(data, data + sizeof...(L)); // RVO
+		}
+	};
+	// L * B + C where L is lit_limbs<...>, R is remaining limbs of L
+	template<value_type B, typename L, widen_type C, value_type ... R>
+	struct lit_muladd;
+	template<value_type B, value_type ... L, widen_type C>
+	struct lit_muladd<B, lit_limbs<L...>, C> {
+		typedef typename std::conditional<C != 0, lit_limbs<L..., static_cast<value_type>(C)>, lit_limbs<L...>>::type type;
+	};
+	template<value_type B, value_type ... L, widen_type C, value_type H, value_type ... R>
+	struct lit_muladd<B, lit_limbs<L...>, C, H, R...>
+		: lit_muladd<B, lit_limbs<L..., static_cast<value_type>(static_cast<widen_type>(H) * B + C)>, ((static_cast<widen_type>(H) * B + C) >> limits_type::digits), R...> {};
+	static constexpr value_type lit_digit(char c) {
+		return c <= '9' ? c - '0' : c <= 'Z' ? c - 'A' + 10 : c - 'a' + 10;
+	}
+	// NOTE: no consistency check
+	template<value_type B, typename L, char ... c>
+	struct lit_parse { typedef L type; };
+	template<value_type B, value_type ... L, char c0, char ... c>
+	struct lit_parse<B, lit_limbs<L...>, c0, c...> : lit_parse<B, typename lit_muladd<B, lit_limbs<>, lit_digit(c0), L...>::type, c...> {};
+	template<value_type B, value_type ... L, char ... c> // digit separator
+	struct lit_parse<B, lit_limbs<L...>, '\'', c...> : lit_parse<B, lit_limbs<L...>, c...> {};
+	template<char ... c>
+	struct lit_base : lit_parse<10, lit_limbs<>, c...> {};
+	template<char c0, char ... c>
+	struct lit_base<'0', c0, c...> : lit_parse<8, lit_limbs<>, c0, c...> {};
+	template<char ... c>
+	struct lit_base<'0', 'b', c...> : lit_parse<2, lit_limbs<>, c...> {};
+	template<char ... c>
+	struct lit_base<'0', 'B', c...> : lit_parse<2, lit_limbs<>, c...> {};
+	template<char ... c>
+	struct lit_base<'0', 'x', c...> : lit_parse<16, lit_limbs<>, c...> {};
+	template<char ... c>
+	struct lit_base<'0', 'X', c...> : lit_parse<16, lit_limbs<>, c...> {};
 	void normalize() noexcept {
 		while(v.size() > 1 && v.back() == 0) v.pop_back();
 		if(is_zero()) nonneg = true;
@@ -346,9 +928,9 @@ private:
 			typedef typename T::value_type value_type;
 			typedef std::ptrdiff_t difference_type;
 			typedef const value_type* pointer;
-			typedef const value_type& reference;
+			typedef value_type reference; // limbs below the offset are zeros not stored anywhere
 			riterator(const offseter *p_, std::size_t pos_) noexcept : p(p_), pos(pos_) {}
-			reference operator*() noexcept { return pos >= p->off + 1 ? p->st[pos - p->off - 1] : zero(); }
+			reference operator*() noexcept { return pos >= p->off + 1 ? p->st[pos - p->off - 1] : 0; }
 			riterator& operator++() noexcept { --pos; return *this; }
 			riterator operator++(int) noexcept { riterator r(*this); --pos; return r; /* NRVO */ }
 			bool operator==(const riterator& other) const noexcept { return p == other.p && pos == other.pos; }
@@ -362,8 +944,9 @@ private:
 #ifdef TINYMP_KARATSUBA
 		offseter(iterator_type st_, iterator_type end_, std::size_t sz_, std::size_t offset_) noexcept : st(st_), sz(sz_), cap(end_ - st_), off(offset_) {}
 #endif
-		const value_type& operator[](std::size_t idx) const noexcept { return idx >= off ? st[idx - off] : zero(); }
-		value_type& operator[](std::size_t idx) noexcept { return idx >= off ? st[idx - off] : zero(); }
+		// no shared storage stands for the implicit zeros below the offset, so that distinct objects never race
+		value_type operator[](std::size_t idx) const noexcept { return idx >= off ? st[idx - off] : 0; }
+		value_type& operator[](std::size_t idx) noexcept { return st[idx - off]; } // idx should be >= offset()
 		riterator rbegin() const noexcept { return riterator(this, sz + off); }
 		riterator rend() const noexcept { return riterator(this, 0); }
 		std::size_t size() const noexcept { return sz + off; }
@@ -388,13 +971,98 @@ private:
 		std::size_t sz; // valid digits
 		std::size_t cap;
 		std::size_t off;
-		static value_type& zero() noexcept {
-			static value_type zero_;
-			return zero_;
-		}
 	};
 	typedef offseter<vector_type> offseter_type;
 	typedef offseter<cvector_type> coffseter_type;
+	// Montgomery arithmetic modulo odd m with R = 2^(32 * limbs of m), residues are vectors of exactly that many limbs
+	class montgomery
+	{
+	public:
+		explicit montgomery(const tinymp &m_) : m(m_), n(m_.v.size()), t(m_.v.size() + 2) {
+			value_type inv = 1; // m^-1 mod 2^32 by Newton iteration, each step doubles correct bits
+			for(int i = 0; i < 5; ++i) inv *= 2 - m.v[0] * inv;
+			minv = 0 - inv;
+			tinymp r = (tinymp(1) << (n * limits_type::digits)) % m;
+			one_ = limbs(r);
+			r2 = limbs(r * r % m);
+		}
+		std::size_t size() const noexcept { return n; }
+		const vector_type& one() const noexcept { return one_; }
+		vector_type to(const tinymp &a) { // a should be non-negative
+			vector_type r = limbs(a.absless(m) ? a : a % m);
+			mul(r, r, r2);
+			return r; // NRVO
+		}
+		tinymp from(const vector_type &a) {
+			vector_type u(n);
+			u[0] = 1;
+			mul(u, a, u);
+			tinymp r(u.begin(), u.end());
+			r.normalize();
+			return r; // NRVO
+		}
+		// r = a * b / R mod m by CIOS, r may alias a or b
+		void mul(vector_type &r, const vector_type &a, const vector_type &b) noexcept {
+			std::fill(t.begin(), t.end(), 0);
+			for(std::size_t i = 0; i < n; ++i) {
+				widen_type carry = 0;
+				for(std::size_t j = 0; j < n; ++j) {
+					widen_type temp = t[j] + widen_type(a[i]) * b[j] + carry;
+					t[j] = static_cast<value_type>(temp);
+					carry = temp >> limits_type::digits;
+				}
+				widen_type temp = t[n] + carry;
+				t[n] = static_cast<value_type>(temp);
+				t[n + 1] = static_cast<value_type>(temp >> limits_type::digits);
+				value_type q = t[0] * minv;
+				carry = (t[0] + widen_type(q) * m.v[0]) >> limits_type::digits;
+				for(std::size_t j = 1; j < n; ++j) {
+					temp = t[j] + widen_type(q) * m.v[j] + carry;
+					t[j - 1] = static_cast<value_type>(temp);
+					carry = temp >> limits_type::digits;
+				}
+				temp = t[n] + carry;
+				t[n - 1] = static_cast<value_type>(temp);
+				t[n] = t[n + 1] + static_cast<value_type>(temp >> limits_type::digits);
+			}
+			if(t[n] != 0 || !lessthan(t.data(), m.v.data())) sub_n(t.data(), t.data(), m.v.data(), n);
+			std::copy(t.begin(), t.begin() + n, r.begin());
+		}
+		void add(vector_type &r, const vector_type &a, const vector_type &b) const noexcept {
+			if(add_n(r.data(), a.data(), b.data(), n) || !lessthan(r.data(), m.v.data())) sub_n(r.data(), r.data(), m.v.data(), n);
+		}
+		void sub(vector_type &r, const vector_type &a, const vector_type &b) const noexcept {
+			if(sub_n(r.data(), a.data(), b.data(), n)) add_n(r.data(), r.data(), m.v.data(), n);
+		}
+		void half(vector_type &r) const noexcept { // r / 2 mod m
+			value_type carry = (r[0] & 1) ? add_n(r.data(), r.data(), m.v.data(), n) : 0;
+			for(std::size_t i = 0; i + 1 < n; ++i) r[i] = (r[i] >> 1) | (r[i + 1] << (limits_type::digits - 1));
+			r[n - 1] = (r[n - 1] >> 1) | (carry << (limits_type::digits - 1));
+		}
+		vector_type pow(const vector_type &a, const tinymp &e) noexcept { // e should be non-negative
+			vector_type r = one_;
+			for(std::size_t i = e.bit_length(); i > 0; --i) {
+				mul(r, r, r);
+				if(e.test_bit(i - 1)) mul(r, r, a);
+			}
+			return r; // NRVO
+		}
+	private:
+		const tinymp &m; // should outlive this object
+		std::size_t n;
+		value_type minv; // -m^-1 mod 2^32
+		vector_type one_, r2; // R mod m, R^2 mod m
+		vector_type t; // scratch
+		vector_type limbs(const tinymp &a) const {
+			vector_type r(a.v);
+			r.resize(n);
+			return r; // NRVO
+		}
+		bool lessthan(const value_type *a, const value_type *b) const noexcept {
+			for(std::size_t i = n; i > 0; --i) if(a[i - 1] != b[i - 1]) return a[i - 1] < b[i - 1];
+			return false;
+		}
+	};
 	template<typename T>
 	static bool overflow(T carry, T v1, T v2) noexcept {
 		return carry ? v1 <= v2 : v1 < v2;
@@ -429,6 +1097,623 @@ private:
 		}
 		if(carry) v1.push_back(1);
 	}
+	static std::pair<tinymp, tinymp> div_imp(tinymp &&dividend, const tinymp& other) {
+		// dividend is consumed as the initial residual, so an rvalue dividend lends its storage
+		std::pair<tinymp, tinymp> p{ std::piecewise_construct, std::forward_as_tuple(), std::forward_as_tuple(std::move(dividend)) };
+		tinymp & residual = p.second;
+		const bool nonneg = residual.nonneg;
+		if(!(residual.absless(other))) {
+			tinymp& r = p.first;
+			r.v.resize(residual.v.size() - other.v.size() + 1);
+			reduce_(residual, other, r.v.data());
+			r.normalize();
+			r.nonneg = !(nonneg ^ other.nonneg);
+		}
+		return p;
+	}
+	// residual %= other keeping the sign of residual, quotient limbs are stored into q unless it is nullptr
+	static void reduce_(tinymp &residual, const tinymp& other, value_type *q) {
+		// TODO: check Knuth algorithm
+		const bool nonneg = residual.nonneg;
+		if(!(residual.absless(other))) {
+			const std::size_t qn = residual.v.size() - other.v.size() + 1;
+			residual.nonneg = true;
+			for(std::size_t i = 0; i < qn; ++i) {
+				std::size_t idxr = qn - i - 1;
+				if(residual.v.size() < idxr + other.v.size() || absless(residual.v, coffseter_type(other.v, idxr))) continue;
+				widen_type res = 0;
+				if(residual.v.size() > idxr + other.v.size()) {
+					res = widen_type(residual.v[idxr + other.v.size()]) << limits_type::digits;
+				}
+				res += residual.v[idxr + other.v.size() - 1];
+				widen_type top = other.v.back();
+				if(2 <= idxr + other.v.size() && other.v.size() >= 2) {
+					std::size_t bres = wlimits_type::digits - clz(res);
+					std::size_t btop = wlimits_type::digits - clz(top);
+					auto bits = std::min<std::size_t>(32, wlimits_type::digits - std::max(bres, btop));
+					if(bits) {
+						res <<= bits;
+						res += residual.v[idxr + other.v.size() - 2] >> (limits_type::digits - bits);
+						top <<= bits;
+						top += other.v[other.v.size() - 2] >> (limits_type::digits - bits);
+					}
+				}
+				widen_type candidate = res / top; // candidate may exceed limits_type::max()
+				--candidate; // res >= top if !absless(residual.v, coffseter_type(other.v, idxr))
+				candidate = std::min<widen_type>(candidate, limits_type::max());
+				auto temp = other * candidate;
+				while(candidate == 0 || !absless(residual.v, offseter_type(temp.v, idxr))) {
+					++candidate;
+					temp += other; // temp = other * candidate seems to be faster if other has 1000 digits (base-10) order
+				}
+				--candidate;
+				temp -= other; // temp = other * candidate seems to be faster if other has 1000 digits (base-10) order
+				sub(residual.v, offseter_type(temp.v, idxr)); // residual -= (temp << (idxr * BITS));
+				if(q) q[idxr] = candidate;
+			}
+			if(!nonneg) residual.flip_();
+		}
+	}
+	// *this = op(*this, other) over two's complement images of both operands
+	template<typename Op>
+	tinymp& bitwise_(const tinymp& other, Op op) {
+		const auto m = std::min(v.size(), other.v.size());
+		if(nonneg && other.nonneg) { // magnitudes as they are
+			if(v.size() < other.v.size()) v.resize(other.v.size());
+			for(std::size_t i = 0; i < m; ++i) v[i] = op(v[i], other.v[i]);
+			for(std::size_t i = m; i < v.size(); ++i) v[i] = op(v[i], i < other.v.size() ? other.v[i] : 0);
+			normalize();
+			return *this;
+		}
+		// the image of -x is ~(x - 1), the decrement and the negation of a negative result are done on the fly
+		const value_type sa = nonneg ? 0 : limits_type::max(), sb = other.nonneg ? 0 : limits_type::max();
+		const value_type sr = op(sa, sb);
+		value_type ba = sa & 1, bb = sb & 1, carry = sr & 1;
+		v.resize(std::max(v.size(), other.v.size()) + 1);
+		for(std::size_t i = 0; i < v.size(); ++i) {
+			value_type a = v[i], b = i < other.v.size() ? other.v[i] : 0;
+			value_type ta = (a - ba) ^ sa, tb = (b - bb) ^ sb;
+			ba = ba && a == 0;
+			bb = bb && b == 0;
+			value_type r = (op(ta, tb) ^ sr) + carry;
+			carry = carry && r == 0;
+			v[i] = r;
+		}
+		nonneg = sr == 0;
+		normalize();
+		return *this;
+	}
+	// |*this| >>= s, truncating toward zero without normalization
+	void rshift_abs(std::size_t s) {
+		auto count = s / limits_type::digits;
+		auto bits = s % limits_type::digits;
+		auto n = v.size();
+		if(count >= n) {
+			v.assign(1, 0);
+			return;
+		}
+		value_type *p = v.data();
+		if(bits == 0) {
+			std::memmove(p, p + count, (n - count) * sizeof(value_type));
+		} else {
+			for(std::size_t idx = 0; idx + count + 1 < n; ++idx)
+				p[idx] = static_cast<value_type>(((widen_type(p[idx + count + 1]) << limits_type::digits) | p[idx + count]) >> bits);
+			p[n - count - 1] = p[n - 1] >> bits;
+		}
+		v.resize(n - count);
+	}
+	// stream insertion of formatted chars, padded by width, fill and adjustfield as built-in inserters do
+	static std::ostream& put_padded(std::ostream &os, const char *first, const char *last) {
+		std::ostream::sentry ok(os);
+		if(!ok) return os;
+		const std::streamsize len = last - first, pad = os.width() > len ? os.width() - len : 0;
+		os.width(0);
+		const auto adjust = os.flags() & std::ios_base::adjustfield;
+		const char *mid = adjust == std::ios_base::left ? last : adjust == std::ios_base::internal && *first == '-' ? first + 1 : first;
+		auto sb = os.rdbuf();
+		bool good = sb->sputn(first, mid - first) == mid - first;
+		for(std::streamsize i = 0; good && i < pad; ++i) good = !std::ostream::traits_type::eq_int_type(sb->sputc(os.fill()), std::ostream::traits_type::eof());
+		if(!good || sb->sputn(mid, last - mid) != last - mid) os.setstate(std::ios_base::badbit);
+		return os;
+	}
+	// stream extraction, stops at the first character not a digit in the base
+	std::istream& extract_(std::istream &is) {
+		typedef std::istream::traits_type traits_type;
+		std::istream::sentry se(is);
+		if(!se) return is;
+		const value_type base = (is.flags() & std::ios_base::oct) ? 8 : (is.flags() & std::ios_base::hex) ? 16 : 10;
+		value_type chunk_scale = base; // the largest power of base in a limb
+		while(chunk_scale <= limits_type::max() / base) chunk_scale *= base;
+		auto sb = is.rdbuf();
+		auto c = sb->sgetc();
+		const bool negative = traits_type::eq_int_type(c, traits_type::to_int_type('-'));
+		if(negative || traits_type::eq_int_type(c, traits_type::to_int_type('+'))) c = sb->snextc();
+		v.assign(1, 0);
+		bool digits = false;
+		value_type chunk = 0, scale = 1;
+		for(;; c = sb->snextc()) {
+			if(traits_type::eq_int_type(c, traits_type::eof())) {
+				is.setstate(std::ios_base::eofbit);
+				break;
+			}
+			const char ch = traits_type::to_char_type(c);
+			const value_type d = '0' <= ch && ch <= '9' ? ch - '0' : 'a' <= ch && ch <= 'z' ? ch - 'a' + 10 : 'A' <= ch && ch <= 'Z' ? ch - 'A' + 10 : base;
+			if(d >= base) break;
+			digits = true;
+			chunk = chunk * base + d;
+			scale *= base;
+			if(scale == chunk_scale) {
+				muladd_ui_(scale, chunk);
+				chunk = 0;
+				scale = 1;
+			}
+		}
+		if(scale > 1) muladd_ui_(scale, chunk);
+		nonneg = !negative;
+		normalize();
+		if(!digits) is.setstate(std::ios_base::failbit);
+		return is;
+	}
+	// |*this| = |*this| * m + a in a single carry pass
+	void muladd_ui_(value_type m, value_type a) {
+		widen_type carry = a;
+		for(auto &val : v) {
+			widen_type temp = widen_type(val) * m + carry;
+			val = static_cast<value_type>(temp);
+			carry = temp >> limits_type::digits;
+		}
+		if(carry) v.push_back(static_cast<value_type>(carry));
+	}
+	// serialization helpers
+	widen_type header() const noexcept {
+		return is_zero() ? 0 : (widen_type(v.size()) << 1) | (nonneg ? 0 : 1);
+	}
+	void from_header(widen_type h) { // limbs are left for the caller to fill
+		v.assign(std::max<std::size_t>(h >> 1, 1), 0);
+		nonneg = (h >> 1) == 0 || !(h & 1);
+	}
+	static int get_varint(widen_type &h, int shift, unsigned char c) noexcept { // 1 if more bytes follow, 0 at the end, -1 if non-canonical
+		if(shift == 63 && c > 1) return -1; // the 10th byte carries the top bit only
+		if(shift > 0 && c == 0) return -1; // overlong
+		h |= widen_type(c & 0x7F) << shift;
+		if(c & 0x80) return 1;
+		return h == 1 ? -1 : 0; // negative zero
+	}
+	static bool little_endian() noexcept { // folded into a constant by compilers
+		const value_type one = 1;
+		unsigned char c;
+		std::memcpy(&c, &one, 1);
+		return c == 1;
+	}
+	static char* put_varint(char *p, widen_type h) noexcept {
+		for(; h > 0x7F; h >>= 7) *p++ = static_cast<char>((h & 0x7F) | 0x80);
+		*p++ = static_cast<char>(h);
+		return p;
+	}
+	static char* put_limbs(char *p, const value_type *src, std::size_t n) noexcept {
+		if(little_endian()) {
+			std::memcpy(p, src, n * sizeof(value_type));
+			return p + n * sizeof(value_type);
+		}
+		for(std::size_t idx = 0; idx < n; ++idx) {
+			for(std::size_t i = 0; i < sizeof(value_type); ++i) *p++ = static_cast<char>(src[idx] >> (8 * i));
+		}
+		return p;
+	}
+	static void get_limbs(value_type *dst, const char *p, std::size_t n) noexcept {
+		if(little_endian()) {
+			std::memcpy(dst, p, n * sizeof(value_type));
+			return;
+		}
+		for(std::size_t idx = 0; idx < n; ++idx) {
+			value_type val = 0;
+			for(std::size_t i = 0; i < sizeof(value_type); ++i) val |= value_type(static_cast<unsigned char>(*p++)) << (8 * i);
+			dst[idx] = val;
+		}
+	}
+	// odd primes below 256
+	static const vector_type& small_primes() {
+		static const vector_type primes = {
+			3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97,
+			101, 103, 107, 109, 113, 127, 131, 137, 139, 149, 151, 157, 163, 167, 173, 179, 181, 191, 193, 197, 199,
+			211, 223, 227, 229, 233, 239, 241, 251
+		};
+		return primes;
+	}
+	// calls f(p) for each of small_primes() dividing |n| until f returns false
+	// one remainder pass covers a product of primes within a limb
+	template<typename F>
+	static void for_small_prime_divisors(const tinymp &n, F f) {
+		const auto &primes = small_primes();
+		for(std::size_t i = 0; i < primes.size(); ) {
+			std::size_t j = i;
+			widen_type prod = 1;
+			while(j < primes.size() && prod * primes[j] <= limits_type::max()) prod *= primes[j++];
+			value_type r = n.mod_ui(static_cast<value_type>(prod));
+			for(; i < j; ++i) if(r % primes[i] == 0 && !f(primes[i])) return;
+		}
+	}
+	// a non-trivial factor of odd composite n by Brent's variant of Pollard's rho on x^2 + c
+	// |x - y| is accumulated over blocks of iterations to take one GCD per block
+	static tinymp pollard_brent(const tinymp &n) {
+		const std::size_t block = 100;
+		montgomery mont(n);
+		for(value_type c = 1; ; ++c) {
+			const vector_type cm = mont.to(c);
+			auto f = [&](vector_type &x) { mont.mul(x, x, x); mont.add(x, x, cm); };
+			auto gcd_n = [&](const vector_type &x) { tinymp t(x.begin(), x.end()); t.normalize(); return gcd(t, n); };
+			vector_type x, y = mont.to(2), ys, q = mont.one(), diff(mont.size());
+			tinymp g = 1;
+			for(std::size_t r = 1; g == 1; r *= 2) {
+				x = y;
+				for(std::size_t i = 0; i < r; ++i) f(y);
+				for(std::size_t k = 0; k < r && g == 1; k += block) {
+					ys = y;
+					for(std::size_t i = 0; i < std::min(block, r - k); ++i) {
+						f(y);
+						mont.sub(diff, x, y);
+						mont.mul(q, q, diff);
+					}
+					g = gcd_n(q); // scaling by R does not matter as R is coprime to n
+				}
+			}
+			if(g == n) { // the block overshot, retrace it one step at a time
+				do {
+					f(ys);
+					mont.sub(diff, x, ys);
+					g = gcd_n(diff);
+				} while(g == 1);
+			}
+			if(g != n) return g;
+		}
+	}
+	// primes <= n by sieve of Eratosthenes
+	static vector_type primes_upto(value_type n) {
+		vector_type r;
+		if(n < 2) return r;
+		std::vector<bool> composite(static_cast<std::size_t>(widen_type(n) + 1)); // n + 1 wraps for the largest n
+		for(widen_type i = 2; i <= n; ++i) {
+			if(composite[i]) continue;
+			r.push_back(static_cast<value_type>(i));
+			for(widen_type j = i * i; j <= n; j += i) composite[j] = true;
+		}
+		return r; // NRVO
+	}
+	// product of p[0..n) split in halves so that operands of each multiplication have similar sizes
+	template<typename T> // T: value_type or tinymp
+	static tinymp product_tree(const T *p, std::size_t n) {
+		if(n <= 16) {
+			tinymp r = 1;
+			for(std::size_t i = 0; i < n; ++i) r *= p[i];
+			return r; // NRVO
+		}
+		tinymp r = product_tree(p, n / 2);
+		return r *= product_tree(p + n / 2, n - n / 2);
+	}
+#ifdef TINYMP_PARALLEL
+	// [0, n) is split into min(chunks, n) contiguous chunks, f(i, first, last) runs for each on its own thread
+	// the calling thread takes chunk 0, so that nothing is spawned for a single chunk
+	// all threads are joined before the first exception thrown by any chunk is rethrown
+	template<typename F>
+	static void parallel_chunks(std::size_t n, std::size_t chunks, F f) {
+		chunks = std::min(std::max<std::size_t>(chunks, 1), n);
+		if(chunks == 0) return;
+		std::vector<std::exception_ptr> errors(chunks);
+		auto run = [&](std::size_t i) {
+			try {
+				f(i, chunk_first(i, n, chunks), chunk_first(i + 1, n, chunks));
+			} catch(...) {
+				errors[i] = std::current_exception();
+			}
+		};
+		std::vector<std::thread> workers;
+		workers.reserve(chunks - 1);
+		std::size_t spawned = 1;
+		try {
+			for(; spawned < chunks; ++spawned) workers.emplace_back(run, spawned);
+		} catch(...) {} // chunks without a thread run on the calling thread
+		for(auto i = spawned; i < chunks; ++i) run(i);
+		run(0);
+		for(auto &w : workers) w.join();
+		for(auto &e : errors) if(e) std::rethrow_exception(e);
+	}
+	static std::size_t chunk_first(std::size_t i, std::size_t n, std::size_t chunks) noexcept {
+		return i * n / chunks;
+	}
+#endif
+	// Miller-Rabin test to base a for odd n > a
+	static bool strong_probable_prime(const tinymp &n, montgomery &mont, value_type a) {
+		tinymp nm1 = n - 1;
+		auto s = nm1.count_trailing_zeros();
+		vector_type minus_one = mont.to(nm1);
+		vector_type x = mont.pow(mont.to(a), nm1 >> s);
+		if(x == mont.one() || x == minus_one) return true;
+		for(std::size_t r = 1; r < s; ++r) {
+			mont.mul(x, x, x);
+			if(x == minus_one) return true;
+			if(x == mont.one()) return false;
+		}
+		return false;
+	}
+	// Jacobi symbol (a/m) for odd m
+	static int jacobi(widen_type a, widen_type m) noexcept {
+		int r = 1;
+		a %= m;
+		while(a != 0) {
+			while((a & 1) == 0) {
+				a >>= 1;
+				if((m & 7) == 3 || (m & 7) == 5) r = -r;
+			}
+			std::swap(a, m);
+			if((a & 3) == 3 && (m & 3) == 3) r = -r;
+			a %= m;
+		}
+		return m == 1 ? r : 0;
+	}
+	// strong Lucas test with P = 1, Q = (1 - D) / 4 and the first D in 5, -7, 9, -11, ... such that (D/n) = -1, n should be odd
+	static bool strong_lucas_probable_prime(const tinymp &n, montgomery &mont) {
+		long long d = 5;
+		for(int count = 0; ; ++count, d = d > 0 ? -(d + 2) : -d + 2) {
+			value_type q = static_cast<value_type>(d > 0 ? d : -d);
+			int j = jacobi(n.mod_ui(q), q); // (|D|/n) by reciprocity
+			if((q & 3) == 3 && (n.v[0] & 3) == 3) j = -j;
+			if(d < 0 && (n.v[0] & 3) == 3) j = -j; // (-1/n)
+			if(j == -1) break;
+			if(j == 0 && n != q) return false;
+			if(count == 8 && is_square(n)) return false; // no such D for squares
+		}
+		auto to_signed = [&](long long x) {
+			vector_type r = mont.to(tinymp(static_cast<value_type>(x > 0 ? x : -x)));
+			if(x < 0) mont.sub(r, vector_type(mont.size()), r);
+			return r;
+		};
+		const vector_type D = to_signed(d), Q = to_signed((1 - d) / 4), zero(mont.size());
+		tinymp np1 = n + 1;
+		auto s = np1.count_trailing_zeros();
+		tinymp k = np1 >> s;
+		vector_type U = zero, V = mont.one(), Qk = mont.one(), temp(mont.size());
+		mont.add(V, V, V); // V_0 = 2
+		for(std::size_t i = k.bit_length(); i > 0; --i) {
+			// U_2k = U_k V_k, V_2k = V_k^2 - 2 Q^k, Q^2k = (Q^k)^2
+			mont.mul(U, U, V);
+			mont.mul(V, V, V);
+			mont.sub(V, V, Qk);
+			mont.sub(V, V, Qk);
+			mont.mul(Qk, Qk, Qk);
+			if(k.test_bit(i - 1)) {
+				// U_k+1 = (P U_k + V_k) / 2, V_k+1 = (D U_k + P V_k) / 2, Q^k+1 = Q^k Q
+				mont.mul(temp, D, U);
+				mont.add(U, U, V);
+				mont.half(U);
+				mont.add(V, V, temp);
+				mont.half(V);
+				mont.mul(Qk, Qk, Q);
+			}
+		}
+		if(U == zero || V == zero) return true;
+		for(std::size_t r = 1; r < s; ++r) {
+			mont.mul(V, V, V);
+			mont.sub(V, V, Qk);
+			mont.sub(V, V, Qk);
+			mont.mul(Qk, Qk, Qk);
+			if(V == zero) return true;
+		}
+		return false;
+	}
+	// false if |n| can not be a p-th power, judged by r64 = |n| % 64 and r = |n| % 45045 (= 5 * 7 * 9 * 11 * 13)
+	static bool maybe_power(value_type p, value_type r64, value_type r) noexcept {
+		switch(p) {
+		case 2: { // squares mod 64, 63, 65 and 11
+			const std::uint64_t q65[] = { 0x218A019866014613ULL, 0x1ULL };
+			return (0x0202021202030213ULL >> r64 & 1) && (0x0402483012450293ULL >> (r % 63) & 1)
+				&& (q65[r % 65 / 64] >> (r % 65 % 64) & 1) && (0x23BULL >> (r % 11) & 1);
+		}
+		case 3: // cubes mod 63 and 13
+			return (0x4080001818000103ULL >> (r % 63) & 1) && (0x1123ULL >> (r % 13) & 1);
+		case 5: // fifth powers mod 11
+			return 0x403ULL >> (r % 11) & 1;
+		default:
+			return true;
+		}
+	}
+	// false if |v| is not a p-th power modulo some primes q = 2kp + 1, where x != 0 is a p-th power iff x^((q-1)/p) == 1
+	static bool maybe_power_mod(const tinymp &v, value_type p) noexcept {
+		int tested = 0;
+		for(widen_type q = 2 * widen_type(p) + 1; tested < 4 && q <= limits_type::max(); q += 2 * widen_type(p)) {
+			if(!is_prime_ui(static_cast<value_type>(q))) continue;
+			++tested;
+			const value_type x = v.mod_ui(static_cast<value_type>(q));
+			if(x != 0 && powmod_ui(x, static_cast<value_type>((q - 1) / p), static_cast<value_type>(q)) != 1) return false;
+		}
+		return true;
+	}
+	static bool is_prime_ui(value_type n) noexcept { // trial division for small n
+		if(n < 4) return n >= 2;
+		if(n % 2 == 0) return false;
+		for(widen_type d = 3; d * d <= n; d += 2) if(n % d == 0) return false;
+		return true;
+	}
+	static value_type powmod_ui(value_type x, value_type e, value_type m) noexcept {
+		widen_type r = 1 % m, b = x % m;
+		for(; e; e >>= 1, b = b * b % m) if(e & 1) r = r * b % m;
+		return static_cast<value_type>(r);
+	}
+	static value_type powmod_2_32(value_type x, value_type e) noexcept { // x^e mod 2^32
+		value_type r = 1;
+		for(; e; e >>= 1, x *= x) if(e & 1) r *= x;
+		return r;
+	}
+	// bit scan primitives, clz(0) is the width of the argument
+#if defined(__GNUC__)
+	static int clz(std::uint32_t x) noexcept { return x ? __builtin_clz(x) : 32; }
+	static int clz(std::uint64_t x) noexcept { return x ? __builtin_clzll(x) : 64; }
+	static int ctz(std::uint32_t x) noexcept { return x ? __builtin_ctz(x) : 32; }
+	static int popcount(std::uint32_t x) noexcept { return __builtin_popcount(x); }
+#else
+	template<typename T>
+	static int clz(T x) noexcept { int r = std::numeric_limits<T>::digits; while(x) { x >>= 1; --r; } return r; }
+	static int ctz(std::uint32_t x) noexcept { int r = 0; while(r < 32 && !((x >> r) & 1)) ++r; return r; }
+	static int popcount(std::uint32_t x) noexcept { int r = 0; while(x) { x &= x - 1; ++r; } return r; }
+#endif
+	// mixes 64-bit words with a multiply-rotate step and finishes with the splitmix64 finalizer
+	static std::size_t hash_limbs(const value_type *p, std::size_t n, bool nonneg_) noexcept {
+		const std::uint64_t k = 0x9E3779B97F4A7C15ULL;
+		std::uint64_t h = nonneg_ ? n : ~std::uint64_t(n);
+		std::size_t i = 0;
+		for(; i + 1 < n; i += 2) {
+			std::uint64_t w = p[i] | (std::uint64_t(p[i + 1]) << limits_type::digits);
+			h = (((h << 5) | (h >> 59)) ^ w) * k;
+		}
+		if(i < n) h = (((h << 5) | (h >> 59)) ^ p[i]) * k;
+		h ^= h >> 30; h *= 0xBF58476D1CE4E5B9ULL;
+		h ^= h >> 27; h *= 0x94D049BB133111EBULL;
+		h ^= h >> 31;
+		return static_cast<std::size_t>(h);
+	}
+	// floor(|n|^(1/k)) for k >= 1
+	// the root of the upper half bits gives an overestimate of half precision, then Newton steps decrease it to the root
+	static tinymp iroot_abs(const tinymp &n, value_type k) {
+		if(k == 1 || n.is_zero()) return n.nonneg ? n : -n;
+		auto b = n.bit_length();
+		auto m = b / (2 * k);
+		tinymp x = m == 0 ? tinymp(1) << ((b + k - 1) / k) : (iroot_abs(n >> (k * m), k) + 1) << m;
+		tinymp a(n);
+		a.nonneg = true;
+		while(true) {
+			tinymp y = x * (k - 1) + a / pow(x, k - 1); // x^(k-1) by binary exponentiation
+			y /= k;
+			if(!(y < x)) return x;
+			x = std::move(y);
+		}
+	}
+	// *this += (onneg ? |b| : -|b|) and *this *= (onneg ? |b| : -|b|) for limbs b[0..bn) not in v
+	tinymp& add_(const value_type *b, std::size_t bn, bool onneg) {
+		if(nonneg ^ onneg) { nonneg ^= sub(v, b, bn); normalize(); }
+		else add(v, b, bn);
+		return *this;
+	}
+	tinymp& mul_(const value_type *b, std::size_t bn, bool onneg) {
+		// in-place schoolbook: rows from the top limb never overwrite unread lower limbs
+		auto n = v.size();
+		v.resize(n + bn);
+		for(auto i = n; i > 0; --i) {
+			value_type s = v[i - 1];
+			v[i - 1] = 0;
+			if(s) addmul_row(v, b, bn, s, i - 1);
+		}
+		nonneg = !(nonneg ^ onneg);
+		normalize();
+		return *this;
+	}
+	// r[off..] += b * s in a single carry pass, r grows if the carry runs off the top
+	static void addmul_row(vector_type &r, const value_type *b, std::size_t bn, value_type s, std::size_t off) {
+		widen_type carry = 0;
+		for(std::size_t j = 0; j < bn; ++j) {
+			widen_type temp = widen_type(b[j]) * s + r[off + j] + carry;
+			r[off + j] = temp;
+			carry = temp >> limits_type::digits;
+		}
+		for(std::size_t idx = off + bn; carry != 0; ++idx) {
+			if(idx == r.size()) r.push_back(0);
+			widen_type temp = widen_type(r[idx]) + carry;
+			r[idx] = temp;
+			carry = temp >> limits_type::digits;
+		}
+	}
+	// r[off..] -= b * s in a single borrow pass, returns true if the borrow runs off the top (r wraps around)
+	static bool submul_row(vector_type &r, cvector_type &b, value_type s, std::size_t off) noexcept {
+		widen_type borrow = 0;
+		for(std::size_t j = 0; j < b.size(); ++j) {
+			widen_type temp = widen_type(b[j]) * s + borrow;
+			value_type low = temp;
+			borrow = (temp >> limits_type::digits) + (r[off + j] < low);
+			r[off + j] -= low;
+		}
+		for(std::size_t idx = off + b.size(); borrow != 0 && idx < r.size(); ++idx) {
+			value_type low = borrow;
+			borrow = r[idx] < low;
+			r[idx] -= low;
+		}
+		return borrow != 0;
+	}
+	// two's complement in place, turns a wrapped-around difference into its magnitude
+	static void negate(vector_type &r) noexcept {
+		value_type carry = 1;
+		for(auto &val : r) {
+			val = ~val + carry;
+			carry = carry && val == 0;
+		}
+	}
+	// *this += (pnonneg ? |x| : -|x|) * |y| where x is given as limbs
+	tinymp& addmul_imp(const value_type *x, std::size_t xn, cvector_type &y, bool pnonneg) {
+		if((xn == 1 && x[0] == 0) || (y.size() == 1 && y[0] == 0)) return *this;
+		v.resize(std::max(v.size(), xn + y.size()));
+		if(nonneg == pnonneg) {
+			for(std::size_t i = 0; i < xn; ++i)
+				if(x[i]) addmul_row(v, y.data(), y.size(), x[i], i);
+		} else {
+			bool wrapped = false;
+			for(std::size_t i = 0; i < xn; ++i)
+				if(x[i]) wrapped |= submul_row(v, y, x[i], i);
+			if(wrapped) {
+				negate(v);
+				nonneg = !nonneg;
+			}
+		}
+		normalize();
+		return *this;
+	}
+	// contiguous kernels, r may alias a or b
+	// widened sums let the compiler emit an add-with-carry chain instead of comparisons
+	static value_type add_n(value_type *r, const value_type *a, const value_type *b, std::size_t n) noexcept {
+		value_type carry = 0;
+		for(std::size_t i = 0; i < n; ++i) {
+			widen_type temp = widen_type(a[i]) + b[i] + carry;
+			r[i] = static_cast<value_type>(temp);
+			carry = static_cast<value_type>(temp >> limits_type::digits);
+		}
+		return carry;
+	}
+	static value_type sub_n(value_type *r, const value_type *a, const value_type *b, std::size_t n) noexcept {
+		value_type borrow = 0;
+		for(std::size_t i = 0; i < n; ++i) {
+			widen_type temp = widen_type(a[i]) - b[i] - borrow;
+			r[i] = static_cast<value_type>(temp);
+			borrow = static_cast<value_type>(temp >> limits_type::digits) & 1;
+		}
+		return borrow;
+	}
+	// magnitudes given as limbs b[0..bn) without leading zeros, b may alias v1 as long as v1 does not grow first
+	static void add(vector_type &v1, const value_type *b, std::size_t bn) {
+		if(v1.size() < bn) v1.resize(bn);
+		value_type carry = add_n(v1.data(), v1.data(), b, bn);
+		for(std::size_t idx = bn; carry != 0 && idx < v1.size(); ++idx) carry = ++v1[idx] == 0;
+		if(carry) v1.push_back(1);
+	}
+	static bool sub(vector_type &v1, const value_type *b, std::size_t bn) {
+		bool sub = absless(v1, b, bn);
+		if(sub) { // v1 = b - v1
+			auto n = v1.size();
+			v1.resize(bn);
+			value_type borrow = sub_n(v1.data(), b, v1.data(), n);
+			for(std::size_t idx = n; idx < bn; ++idx) {
+				v1[idx] = b[idx] - borrow;
+				borrow = borrow && b[idx] == 0;
+			}
+		} else {
+			value_type borrow = sub_n(v1.data(), v1.data(), b, bn);
+			for(std::size_t idx = bn; borrow != 0; ++idx) borrow = v1[idx]-- == 0;
+		}
+		normalize(v1);
+		return sub;
+	}
+	static void add(vector_type &v1, cvector_type &v2) { add(v1, v2.data(), v2.size()); }
+	static bool sub(vector_type &v1, cvector_type &v2) { return sub(v1, v2.data(), v2.size()); }
+	static bool absless(cvector_type &v1, const value_type *b, std::size_t bn) noexcept {
+		if(v1.size() != bn) return v1.size() < bn;
+		for(std::size_t i = bn; i > 0; --i) if(v1[i - 1] != b[i - 1]) return v1[i - 1] < b[i - 1];
+		return false;
+	}
 	template<typename T> // T is vector<V> or offseter<V>
 	static void normalize(T &v) noexcept { // always shrink or nothing to do
 		auto idx = v.size() - 1; // size() should be more than 0
@@ -588,6 +1873,376 @@ inline tinymp stotmp(const std::string& s, int base = 10)
 {
 	return tinymp::stotmp(s, base); // RVO
 }
+inline tinymp factorial(tinymp::value_type n)
+{
+	return tinymp::factorial(n); // RVO
+}
+inline tinymp binomial(tinymp::value_type n, tinymp::value_type k)
+{
+	return tinymp::binomial(n, k); // RVO
+}
+inline tinymp primorial(tinymp::value_type n)
+{
+	return tinymp::primorial(n); // RVO
+}
+
+// fixed-width counterpart of tinymp without heap allocation
+// Bits-bit two's complement, arithmetic wraps around like built-in integers
+// loops have the limb count as a compile-time trip count so that the compiler can fully unroll them
+template<std::size_t Bits>
+class tinymp_fixed
+{
+public:
+	typedef tinymp::value_type value_type;
+private:
+	typedef std::numeric_limits<value_type> limits_type;
+	typedef std::uint64_t widen_type;
+	static_assert(Bits > 0 && Bits % std::numeric_limits<value_type>::digits == 0, "Bits should be a positive multiple of 32");
+	static const std::size_t N = Bits / std::numeric_limits<value_type>::digits;
+	typedef std::array<value_type, N> array_type;
+
+public:
+	constexpr tinymp_fixed() noexcept : v{} {}
+	TINYMP_CONSTEXPR tinymp_fixed(value_type val, bool nonneg_ = true) noexcept : v{{val}} { if(!nonneg_) negate(); }
+	// truncates to the lowest Bits bits
+	explicit tinymp_fixed(const tinymp &t) noexcept : v{} {
+		for(std::size_t i = 0; i < N && i < t.v.size(); ++i) v[i] = t.v[i];
+		if(!t.nonneg) negate();
+	}
+	explicit operator tinymp() const {
+		tinymp_fixed t(*this);
+		if(is_negative()) t.negate();
+		tinymp r(t.v.begin(), t.v.end());
+		r.normalize();
+		if(is_negative()) r.flip_();
+		return r; // NRVO
+	}
+	std::size_t hash() const noexcept {
+		return tinymp::hash_limbs(v.data(), N, true);
+	}
+
+	// compound assignments
+	TINYMP_CONSTEXPR tinymp_fixed& operator+=(const tinymp_fixed &other) noexcept {
+		widen_type carry = 0;
+		for(std::size_t i = 0; i < N; ++i) {
+			carry += widen_type(v[i]) + other.v[i];
+			v[i] = value_type(carry);
+			carry >>= limits_type::digits;
+		}
+		return *this;
+	}
+	TINYMP_CONSTEXPR tinymp_fixed& operator-=(const tinymp_fixed &other) noexcept {
+		widen_type borrow = 0;
+		for(std::size_t i = 0; i < N; ++i) {
+			widen_type temp = widen_type(v[i]) - other.v[i] - borrow;
+			v[i] = value_type(temp);
+			borrow = (temp >> limits_type::digits) & 1;
+		}
+		return *this;
+	}
+	TINYMP_CONSTEXPR tinymp_fixed& operator*=(value_type s) noexcept {
+		widen_type carry = 0;
+		for(std::size_t i = 0; i < N; ++i) {
+			widen_type temp = widen_type(v[i]) * s + carry;
+			v[i] = value_type(temp);
+			carry = temp >> limits_type::digits;
+		}
+		return *this;
+	}
+	TINYMP_CONSTEXPR tinymp_fixed& operator*=(const tinymp_fixed &other) noexcept {
+		array_type r{};
+		for(std::size_t i = 0; i < N; ++i) {
+			widen_type carry = 0;
+			for(std::size_t j = 0; i + j < N; ++j) {
+				widen_type temp = widen_type(v[i]) * other.v[j] + r[i + j] + carry;
+				r[i + j] = value_type(temp);
+				carry = temp >> limits_type::digits;
+			}
+		}
+		v = r;
+		return *this;
+	}
+	TINYMP_CONSTEXPR tinymp_fixed& operator/=(const tinymp_fixed &other) noexcept {
+		return *this = div(other).first;
+	}
+	TINYMP_CONSTEXPR tinymp_fixed& operator%=(const tinymp_fixed &other) noexcept {
+		return *this = div(other).second;
+	}
+	TINYMP_CONSTEXPR tinymp_fixed& operator<<=(std::size_t s) noexcept {
+		std::size_t count = s / limits_type::digits, bits = s % limits_type::digits;
+		for(std::size_t i = N; i > 0; --i) {
+			value_type hi = i - 1 >= count ? v[i - 1 - count] : 0;
+			value_type lo = i - 1 >= count + 1 ? v[i - 2 - count] : 0;
+			v[i - 1] = bits ? (hi << bits) | (lo >> (limits_type::digits - bits)) : hi;
+		}
+		return *this;
+	}
+	// arithmetic shift, rounds toward negative infinity
+	TINYMP_CONSTEXPR tinymp_fixed& operator>>=(std::size_t s) noexcept {
+		std::size_t count = s / limits_type::digits, bits = s % limits_type::digits;
+		value_type fill = is_negative() ? limits_type::max() : 0;
+		for(std::size_t i = 0; i < N; ++i) {
+			value_type lo = i + count < N ? v[i + count] : fill;
+			value_type hi = i + count + 1 < N ? v[i + count + 1] : fill;
+			v[i] = bits ? (lo >> bits) | (hi << (limits_type::digits - bits)) : lo;
+		}
+		return *this;
+	}
+	TINYMP_CONSTEXPR tinymp_fixed& operator&=(const tinymp_fixed &other) noexcept {
+		for(std::size_t i = 0; i < N; ++i) v[i] &= other.v[i];
+		return *this;
+	}
+	TINYMP_CONSTEXPR tinymp_fixed& operator|=(const tinymp_fixed &other) noexcept {
+		for(std::size_t i = 0; i < N; ++i) v[i] |= other.v[i];
+		return *this;
+	}
+	TINYMP_CONSTEXPR tinymp_fixed& operator^=(const tinymp_fixed &other) noexcept {
+		for(std::size_t i = 0; i < N; ++i) v[i] ^= other.v[i];
+		return *this;
+	}
+	TINYMP_CONSTEXPR tinymp_fixed operator~() const noexcept {
+		tinymp_fixed r(*this);
+		for(std::size_t i = 0; i < N; ++i) r.v[i] = ~r.v[i];
+		return r; // NRVO
+	}
+	// arithmetic unary operators
+	TINYMP_CONSTEXPR tinymp_fixed operator+() const noexcept {
+		return *this;
+	}
+	TINYMP_CONSTEXPR tinymp_fixed& flip_() noexcept {
+		negate();
+		return *this;
+	}
+	TINYMP_CONSTEXPR tinymp_fixed operator-() const noexcept {
+		tinymp_fixed r(*this);
+		r.negate();
+		return r; // NRVO
+	}
+	// truncated division as tinymp does, remainder has the sign of the dividend
+	TINYMP_CONSTEXPR std::pair<tinymp_fixed, tinymp_fixed> div(const tinymp_fixed &other) const noexcept {
+		bool n1 = is_negative(), n2 = other.is_negative();
+		tinymp_fixed a(*this), b(other), q, r;
+		if(n1) a.negate();
+		if(n2) b.negate();
+		if(b.limbs() == 1) {
+			widen_type borrow = 0;
+			for(std::size_t i = N; i > 0; --i) {
+				widen_type temp = (borrow << limits_type::digits) + a.v[i - 1];
+				q.v[i - 1] = value_type(temp / b.v[0]);
+				borrow = temp % b.v[0];
+			}
+			r.v[0] = value_type(borrow);
+		} else {
+			for(std::size_t i = a.limbs() * limits_type::digits; i > 0; --i) {
+				r <<= 1;
+				r.v[0] |= (a.v[(i - 1) / limits_type::digits] >> ((i - 1) % limits_type::digits)) & 1;
+				if(!absless(r, b)) {
+					r -= b;
+					q.v[(i - 1) / limits_type::digits] |= value_type(1) << ((i - 1) % limits_type::digits);
+				}
+			}
+		}
+		if(n1 ^ n2) q.negate();
+		if(n1) r.negate();
+		return { q, r };
+	}
+
+	// arithmetic binary operators
+	friend TINYMP_CONSTEXPR tinymp_fixed operator+(tinymp_fixed v1, const tinymp_fixed &v2) noexcept { return v1 += v2; }
+	friend TINYMP_CONSTEXPR tinymp_fixed operator-(tinymp_fixed v1, const tinymp_fixed &v2) noexcept { return v1 -= v2; }
+	friend TINYMP_CONSTEXPR tinymp_fixed operator*(tinymp_fixed v, value_type s) noexcept { return v *= s; }
+	friend TINYMP_CONSTEXPR tinymp_fixed operator*(tinymp_fixed v1, const tinymp_fixed &v2) noexcept { return v1 *= v2; }
+	friend TINYMP_CONSTEXPR tinymp_fixed operator/(const tinymp_fixed &v1, const tinymp_fixed &v2) noexcept { return v1.div(v2).first; }
+	friend TINYMP_CONSTEXPR tinymp_fixed operator%(const tinymp_fixed &v1, const tinymp_fixed &v2) noexcept { return v1.div(v2).second; }
+	// bit-wise binary operators
+	friend TINYMP_CONSTEXPR tinymp_fixed operator&(tinymp_fixed v1, const tinymp_fixed &v2) noexcept { return v1 &= v2; }
+	friend TINYMP_CONSTEXPR tinymp_fixed operator|(tinymp_fixed v1, const tinymp_fixed &v2) noexcept { return v1 |= v2; }
+	friend TINYMP_CONSTEXPR tinymp_fixed operator^(tinymp_fixed v1, const tinymp_fixed &v2) noexcept { return v1 ^= v2; }
+	// increment/decrement operators
+	TINYMP_CONSTEXPR tinymp_fixed& operator++() noexcept { return *this += 1; }
+	TINYMP_CONSTEXPR tinymp_fixed operator++(int) noexcept { tinymp_fixed t(*this); *this += 1; return t; } // NRVO
+	TINYMP_CONSTEXPR tinymp_fixed& operator--() noexcept { return *this -= 1; }
+	TINYMP_CONSTEXPR tinymp_fixed operator--(int) noexcept { tinymp_fixed t(*this); *this -= 1; return t; } // NRVO
+	// shift operators
+	TINYMP_CONSTEXPR tinymp_fixed operator<<(std::size_t s) const noexcept { tinymp_fixed r(*this); r <<= s; return r; } // NRVO
+	TINYMP_CONSTEXPR tinymp_fixed operator>>(std::size_t s) const noexcept { tinymp_fixed r(*this); r >>= s; return r; } // NRVO
+	// comparison
+	friend TINYMP_CONSTEXPR bool operator==(const tinymp_fixed &v1, const tinymp_fixed &v2) noexcept {
+		for(std::size_t i = 0; i < N; ++i) if(v1.v[i] != v2.v[i]) return false;
+		return true;
+	}
+	friend TINYMP_CONSTEXPR bool operator!=(const tinymp_fixed &v1, const tinymp_fixed &v2) noexcept {
+		return !(v1 == v2);
+	}
+	friend TINYMP_CONSTEXPR bool operator<(const tinymp_fixed &v1, const tinymp_fixed &v2) noexcept {
+		if(v1.is_negative() != v2.is_negative()) return v1.is_negative();
+		return absless(v1, v2); // two's complement of the same sign orders as unsigned
+	}
+	friend TINYMP_CONSTEXPR bool operator>(const tinymp_fixed &v1, const tinymp_fixed &v2) noexcept {
+		return v2 < v1;
+	}
+	friend TINYMP_CONSTEXPR bool operator<=(const tinymp_fixed &v1, const tinymp_fixed &v2) noexcept {
+		return !(v2 < v1);
+	}
+	friend TINYMP_CONSTEXPR bool operator>=(const tinymp_fixed &v1, const tinymp_fixed &v2) noexcept {
+		return !(v1 < v2);
+	}
+	// I/O through tinymp
+	friend inline std::istream& operator>>(std::istream &is, tinymp_fixed &v) {
+		tinymp t;
+		is >> t;
+		v = tinymp_fixed(t);
+		return is;
+	}
+	friend inline std::string to_string(const tinymp_fixed &v, int base = 10, bool upper = false) {
+		return to_string(tinymp(v), base, upper);
+	}
+	friend inline std::ostream& operator<<(std::ostream &os, const tinymp_fixed &v) {
+		return os << tinymp(v);
+	}
+
+private:
+	array_type v;
+	TINYMP_CONSTEXPR bool is_negative() const noexcept {
+		return (v[N - 1] >> (limits_type::digits - 1)) != 0;
+	}
+	TINYMP_CONSTEXPR void negate() noexcept {
+		value_type carry = 1;
+		for(std::size_t i = 0; i < N; ++i) {
+			v[i] = ~v[i] + carry;
+			carry = carry && v[i] == 0;
+		}
+	}
+	// number of limbs in use as unsigned, at least 1
+	TINYMP_CONSTEXPR std::size_t limbs() const noexcept {
+		std::size_t n = N;
+		while(n > 1 && v[n - 1] == 0) --n;
+		return n;
+	}
+	// comparison as unsigned
+	static TINYMP_CONSTEXPR bool absless(const tinymp_fixed &v1, const tinymp_fixed &v2) noexcept {
+		for(std::size_t i = N; i > 0; --i) if(v1.v[i - 1] != v2.v[i - 1]) return v1.v[i - 1] < v2.v[i - 1];
+		return false;
+	}
+};
+
+// immutable tinymp with cached hash for large keys of hash tables
+// modification goes through assignment or modify_() and the hash is recalculated
+class tinymp_hashed
+{
+public:
+	tinymp_hashed(tinymp v_ = tinymp()) : v(std::move(v_)), h(v.hash()) {}
+	tinymp_hashed& operator=(tinymp v_) {
+		v = std::move(v_);
+		h = v.hash();
+		return *this;
+	}
+	template<typename F>
+	tinymp_hashed& modify_(F f) {
+		f(v);
+		h = v.hash();
+		return *this;
+	}
+	operator const tinymp&() const noexcept { return v; }
+	const tinymp& get() const noexcept { return v; }
+	std::size_t hash() const noexcept { return h; }
+	friend inline bool operator==(const tinymp_hashed &v1, const tinymp_hashed &v2) noexcept {
+		return v1.h == v2.h && v1.v == v2.v;
+	}
+	friend inline bool operator!=(const tinymp_hashed &v1, const tinymp_hashed &v2) noexcept {
+		return !(v1 == v2);
+	}
+	friend inline bool operator<(const tinymp_hashed &v1, const tinymp_hashed &v2) noexcept {
+		return v1.v < v2.v;
+	}
+	friend inline std::ostream& operator<<(std::ostream &os, const tinymp_hashed& v) {
+		return os << v.v;
+	}
+private:
+	tinymp v;
+	std::size_t h;
+};
+// read-only non-owning view of limbs stored elsewhere, such as a mapped file or another tinymp
+// limbs must outlive the view, arithmetic with a view yields tinymp without copying the viewed limbs
+class tinymp_view
+{
+public:
+	typedef tinymp::value_type value_type;
+	tinymp_view(const value_type *p_, std::size_t n_, bool nonneg_ = true) noexcept : p(p_), n(n_), nonneg(nonneg_) {
+		while(n > 0 && p[n - 1] == 0) --n; // leading zero limbs are not seen, zero has no limbs
+		if(n == 0) nonneg = true;
+	}
+	tinymp_view(const tinymp &v) noexcept : tinymp_view(v.v.data(), v.v.size(), v.nonneg) {}
+	const value_type* data() const noexcept { return p; }
+	std::size_t size() const noexcept { return n; }
+	bool is_zero() const noexcept { return n == 0; }
+	bool is_nonneg() const noexcept { return nonneg; }
+	tinymp_view slice(std::size_t first, std::size_t last) const noexcept { // |*this| >> (32 * first) mod 2^(32 * (last - first))
+		first = std::min(first, n);
+		return tinymp_view(p + first, std::min(last, n) - std::min(first, last));
+	}
+	explicit operator tinymp() const {
+		tinymp r(p, p + n);
+		r.nonneg = nonneg;
+		return r; // NRVO
+	}
+	std::size_t hash() const noexcept { // the same as tinymp::hash() for the same value
+		static const value_type zero = 0;
+		return n == 0 ? tinymp::hash_limbs(&zero, 1, true) : tinymp::hash_limbs(p, n, nonneg);
+	}
+	friend inline bool operator==(const tinymp_view &v1, const tinymp_view &v2) noexcept {
+		return v1.nonneg == v2.nonneg && v1.n == v2.n && std::equal(v1.p, v1.p + v1.n, v2.p);
+	}
+	friend inline bool operator!=(const tinymp_view &v1, const tinymp_view &v2) noexcept { return !(v1 == v2); }
+	friend inline bool operator<(const tinymp_view &v1, const tinymp_view &v2) noexcept {
+		if(v1.nonneg != v2.nonneg) return v2.nonneg;
+		return v1.nonneg ? absless(v1, v2) : absless(v2, v1);
+	}
+	friend inline bool operator>(const tinymp_view &v1, const tinymp_view &v2) noexcept { return v2 < v1; }
+	friend inline bool operator<=(const tinymp_view &v1, const tinymp_view &v2) noexcept { return !(v2 < v1); }
+	friend inline bool operator>=(const tinymp_view &v1, const tinymp_view &v2) noexcept { return !(v1 < v2); }
+	// tinymp operands convert to views implicitly, limbs overlapping the target are copied before it changes
+	friend inline tinymp& operator+=(tinymp &v1, const tinymp_view &v2) {
+		return v2.overlaps(v1) ? v1 += tinymp(v2) : v2.add_to(v1, v2.nonneg);
+	}
+	friend inline tinymp& operator-=(tinymp &v1, const tinymp_view &v2) {
+		return v2.overlaps(v1) ? v1 -= tinymp(v2) : v2.n == 0 ? v1 : v2.add_to(v1, !v2.nonneg);
+	}
+	friend inline tinymp& operator*=(tinymp &v1, const tinymp_view &v2) {
+		return v2.overlaps(v1) ? v1 *= tinymp(v2) : v2.mul_to(v1);
+	}
+	friend inline tinymp operator+(const tinymp_view &v1, const tinymp_view &v2) {
+		tinymp r(v1); r += v2; return r; // NRVO
+	}
+	friend inline tinymp operator-(const tinymp_view &v1, const tinymp_view &v2) {
+		tinymp r(v1); r -= v2; return r; // NRVO
+	}
+	friend inline tinymp operator*(const tinymp_view &v1, const tinymp_view &v2) {
+		const auto &l = v1.n < v2.n ? v2 : v1, &s = v1.n < v2.n ? v1 : v2; // the shorter one is copied
+		tinymp r(s); r *= l; return r; // NRVO
+	}
+	friend inline std::ostream& operator<<(std::ostream &os, const tinymp_view &v) {
+		return os << tinymp(v);
+	}
+private:
+	const value_type *p;
+	std::size_t n;
+	bool nonneg;
+
+	static bool absless(const tinymp_view &v1, const tinymp_view &v2) noexcept {
+		if(v1.n != v2.n) return v1.n < v2.n;
+		for(std::size_t i = v1.n; i > 0; --i) if(v1.p[i - 1] != v2.p[i - 1]) return v1.p[i - 1] < v2.p[i - 1];
+		return false;
+	}
+	tinymp& add_to(tinymp &v, bool sign) const { return v.add_(p, n, sign); }
+	tinymp& mul_to(tinymp &v) const { return v.mul_(p, n, nonneg); }
+	bool overlaps(const tinymp &v) const noexcept {
+		return std::less_equal<const value_type*>()(v.v.data(), p) && std::less<const value_type*>()(p, v.v.data() + v.v.size());
+	}
+};
 namespace std {
 	template<> struct hash<tinymp> { std::size_t operator()(const tinymp& v) const noexcept { return v.hash(); } };
+	template<> struct hash<tinymp_hashed> { std::size_t operator()(const tinymp_hashed& v) const noexcept { return v.hash(); } };
+	template<> struct hash<tinymp_view> { std::size_t operator()(const tinymp_view& v) const noexcept { return v.hash(); } };
+	template<std::size_t Bits> struct hash<tinymp_fixed<Bits>> { std::size_t operator()(const tinymp_fixed<Bits>& v) const noexcept { return v.hash(); } };
 }
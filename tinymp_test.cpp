@@ -4,6 +4,9 @@
 #include <boost/test/data/monomorphic.hpp>
 #include <boost/timer/timer.hpp>
 #include <unordered_map>
+#include <cstdlib>
+#include <thread>
+#include <iomanip>
 
 template<typename T>
 inline T mygcd(T m, T n)
@@ -18,6 +21,7 @@ inline T mygcd(T m, T n)
 }
 
 #define TINYMP_KARATSUBA
+#define TINYMP_PARALLEL
 #pragma GCC diagnostic ignored "-Wmisleading-indentation"
 #include "tinymp.all.cpp"
 #pragma GCC diagnostic warning "-Wmisleading-indentation"
@@ -58,6 +62,26 @@ BOOST_AUTO_TEST_CASE( tinymp_construct )
 	BOOST_TEST( 0xFFFFFFFF000000000000000000000000_tmp == 340282366841710300949110269838224261120_tmp );
 }
 
+BOOST_AUTO_TEST_CASE( tinymp_literal )
+{
+	BOOST_TEST( 0_tmp == 0 );
+	BOOST_TEST( 00_tmp == 0 );
+	BOOST_TEST( 0x0_tmp == 0 );
+	BOOST_TEST( 0b0_tmp == 0 );
+	BOOST_TEST( 0x00000000FFFFFFFF_tmp == 4294967295_tmp );
+	BOOST_TEST( 0777_tmp == 511 );
+	BOOST_TEST( 0xabcdefABCDEF_tmp == stotmp("abcdefABCDEF", 16) );
+	BOOST_TEST( 123456789012345678901234567890123456789012345678901234567890_tmp == stotmp("123456789012345678901234567890123456789012345678901234567890") );
+	BOOST_TEST( -18446744073709551616_tmp == stotmp("-18446744073709551616") );
+	// longer literals are parsed at run time
+	BOOST_TEST( 999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999_tmp == pow(10_tmp, 1050) - 1 );
+	BOOST_TEST( 0x10000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000_tmp == 1_tmp << 1024 );
+#if __cplusplus >= 201402L
+	BOOST_TEST( 0x1'FFFFFFFF'FFFFFFFF_tmp == 36893488147419103231_tmp );
+	BOOST_TEST( 0x1FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF'FFFFFFFF_tmp == (1_tmp << 1024) - 1 + (1_tmp << 1024) );
+#endif
+}
+
 BOOST_AUTO_TEST_CASE( tinymp_pitfall )
 {
 	BOOST_TEST( -10_tmp != -10 ); // because -10 converts to a positive value
@@ -89,6 +113,24 @@ BOOST_AUTO_TEST_CASE( tinymp_arith_shift )
 	}
 }
 
+BOOST_DATA_TEST_CASE( tinymp_arith_shift_2exp, bdata::make(vals), val )
+{
+	tinymp p = 1;
+	for(std::size_t s = 0; s <= 100; ++s, p *= 2) {
+		BOOST_TEST_CONTEXT( "s = " << s ) {
+			BOOST_TEST( (val << s) == val * p );
+			BOOST_TEST( mul_2exp(val, s) == val * p );
+			BOOST_TEST( tdiv_q_2exp(val, s) == val / p );
+			BOOST_TEST( tdiv_r_2exp(val, s) == val % p );
+			tinymp q = val / p;
+			if(val < 0 && val % p != 0) q -= 1;
+			BOOST_TEST( (val >> s) == q );
+			BOOST_TEST( fdiv_q_2exp(val, s) == q );
+			BOOST_TEST( (val >> s) == ((val & ~(p - 1)) / p) );
+		}
+	}
+}
+
 BOOST_AUTO_TEST_CASE( tinymp_arith_additive )
 {
 	BOOST_TEST( to_string(tinymp(0xFFFFFFFFUL)+tinymp(0xFFFFFFFFUL)) == "8589934590" );
@@ -106,6 +148,13 @@ BOOST_AUTO_TEST_CASE( tinymp_arith_additive )
 	// 0x10000000000000000 - 0xFFFFFFFFFFFFFFFF == 0x1
 	BOOST_TEST( 18446744073709551616_tmp - 18446744073709551615_tmp == 1_tmp );
 
+	tinymp ones = (1_tmp << 320) - 1;
+	BOOST_TEST( ones + 1 == 1_tmp << 320 ); // long carry
+	BOOST_TEST( (1_tmp << 320) - 1 == ones ); // long borrow
+	BOOST_TEST( 1 - (1_tmp << 320) == -ones ); // swapped operands
+	BOOST_TEST( ones - (ones << 32) == -(ones << 32) + ones );
+	BOOST_TEST( (ones << 32) + ones == (1_tmp << 352) - 1 + (1_tmp << 320) - (1_tmp << 32) );
+
 	tinymp unit = 4294967296_tmp, t = 1;
 	for(std::size_t i = 1; i <= 10; ++i) {
 		t *= unit;
@@ -245,6 +294,540 @@ BOOST_AUTO_TEST_CASE( tinymp_arith_multiplicative )
 	BOOST_TEST( to_string(mygcd(p1 * p3, p3 * p2)) == to_string(p3) );
 }
 
+BOOST_DATA_TEST_CASE( tinymp_arith_rvalue, bdata::make(vals) * bdata::make(vals), val1, val2 )
+{
+	BOOST_TEST( tinymp(val1) + val2 == val1 + val2 );
+	BOOST_TEST( val1 + tinymp(val2) == val1 + val2 );
+	BOOST_TEST( tinymp(val1) + tinymp(val2) == val1 + val2 );
+	BOOST_TEST( tinymp(val1) - val2 == val1 - val2 );
+	BOOST_TEST( val1 - tinymp(val2) == val1 - val2 );
+	BOOST_TEST( tinymp(val1) - tinymp(val2) == val1 - val2 );
+	BOOST_TEST( tinymp(val1) * val2 == val1 * val2 );
+	BOOST_TEST( val1 * tinymp(val2) == val1 * val2 );
+	BOOST_TEST( tinymp(val1) * tinymp(val2) == val1 * val2 );
+	BOOST_TEST( tinymp(val1) * 10u == val1 * 10u );
+	BOOST_TEST( -tinymp(val1) == -val1 );
+	BOOST_TEST( +tinymp(val1) == +val1 );
+	BOOST_TEST( tinymp(val1) << 33 == val1 << 33 );
+	BOOST_TEST( tinymp(val1) >> 33 == val1 >> 33 );
+	tinymp t(val1);
+	t *= t;
+	BOOST_TEST( t == val1 * val1 );
+	t = val1;
+	t *= val2;
+	BOOST_TEST( t == val2 * val1 );
+	if(val2 != 0) {
+		BOOST_TEST( tinymp(val1) / val2 == val1 / val2 );
+		BOOST_TEST( tinymp(val1) % val2 == val1 % val2 );
+		BOOST_TEST( tinymp(val1) / 7u == val1 / 7u );
+		BOOST_TEST( tinymp(val1) % 7u == val1 % 7u );
+		t = val2;
+		BOOST_TEST( t.div_(t).first == 1 );
+	}
+}
+
+BOOST_DATA_TEST_CASE( tinymp_arith_addmul, bdata::make(vals) * bdata::make(vals) * bdata::make(vals), acc, val1, val2 )
+{
+	tinymp t(acc);
+	BOOST_TEST( addmul(t, val1, val2) == acc + val1 * val2 );
+	t = acc;
+	BOOST_TEST( submul(t, val1, val2) == acc - val1 * val2 );
+	t = acc;
+	BOOST_TEST( addmul_ui(t, val1, 0xFFFFFFFFu) == acc + val1 * 0xFFFFFFFFu );
+	t = acc;
+	BOOST_TEST( submul_ui(t, val1, 0xFFFFFFFFu) == acc - val1 * 0xFFFFFFFFu );
+	t = acc;
+	BOOST_TEST( addmul(t, t, val2) == acc + acc * val2 );
+	t = acc;
+	BOOST_TEST( submul(t, val1, t) == acc - val1 * acc );
+}
+
+BOOST_DATA_TEST_CASE( tinymp_bits, bdata::make(vals), val )
+{
+	std::string s = to_string(val < 0 ? -val : val, 2);
+	BOOST_TEST( val.bit_length() == (val == 0 ? 0 : s.size()) );
+	BOOST_TEST( val.popcount() == std::size_t(std::count(s.begin(), s.end(), '1')) );
+	BOOST_TEST( val.count_trailing_zeros() == (val == 0 ? 0 : s.size() - 1 - s.rfind('1')) );
+	tinymp t = val < 0 ? (1_tmp << 200) + val : val; // two's complement
+	for(std::size_t i = 0; i < 200; ++i) {
+		BOOST_TEST_CONTEXT( "i = " << i ) {
+			BOOST_TEST( val.test_bit(i) == ((t >> i) % 2 == 1) );
+		}
+	}
+	BOOST_TEST( val.test_bit(1000) == (val < 0) );
+}
+
+BOOST_DATA_TEST_CASE( tinymp_bitwise, bdata::make(vals) * bdata::make(vals), val1, val2 )
+{
+	typedef tinymp_fixed<256> fixed; // two's complement reference
+	fixed f1(val1), f2(val2);
+	BOOST_TEST( (val1 & val2) == tinymp(f1 & f2) );
+	BOOST_TEST( (val1 | val2) == tinymp(f1 | f2) );
+	BOOST_TEST( (val1 ^ val2) == tinymp(f1 ^ f2) );
+	BOOST_TEST( ~val1 == tinymp(~f1) );
+	BOOST_TEST( ~val1 == -val1 - 1 );
+	BOOST_TEST( (tinymp(val1) & val2) == (val1 & val2) );
+	BOOST_TEST( (val1 | tinymp(val2)) == (val1 | val2) );
+	BOOST_TEST( (tinymp(val1) ^ tinymp(val2)) == (val1 ^ val2) );
+	BOOST_TEST( ~tinymp(val1) == ~val1 );
+	tinymp t(val1);
+	BOOST_TEST( (t &= t) == val1 );
+	BOOST_TEST( (t |= t) == val1 );
+	BOOST_TEST( (t ^= t) == 0 );
+}
+
+BOOST_AUTO_TEST_CASE( tinymp_bitwise_misc )
+{
+	BOOST_TEST( (-1_tmp >> 1) == -1_tmp );
+	BOOST_TEST( (-4294967296_tmp >> 32) == -1_tmp );
+	BOOST_TEST( (-4294967297_tmp >> 32) == -2_tmp );
+	BOOST_TEST( (-18446744073709551615_tmp >> 64) == -1_tmp );
+	BOOST_TEST( (6_tmp & -4_tmp) == 4 );
+	BOOST_TEST( (-6_tmp & -4_tmp) == -8_tmp );
+	BOOST_TEST( (-6_tmp | 4_tmp) == -2_tmp );
+	BOOST_TEST( (-6_tmp ^ -4_tmp) == 6 );
+	BOOST_TEST( (-4294967296_tmp & -4294967296_tmp) == -4294967296_tmp );
+	BOOST_TEST( (-18446744073709551616_tmp | -18446744073709551616_tmp) == -18446744073709551616_tmp );
+	BOOST_TEST( (-18446744073709551615_tmp & -18446744073709551615_tmp) == -18446744073709551615_tmp );
+	BOOST_TEST( (-1_tmp & 0xFFFFFFFFFFFFFFFFFFFFFFFF_tmp) == 0xFFFFFFFFFFFFFFFFFFFFFFFF_tmp );
+	BOOST_TEST( (0xF0F0F0F0F0F0F0F0F0F0F0F0_tmp ^ 0xFFFFFFFFFFFFFFFF_tmp) == 0xF0F0F0F00F0F0F0F0F0F0F0F_tmp );
+	BOOST_TEST( ~0_tmp == -1_tmp );
+	BOOST_TEST( ~4294967295_tmp == -4294967296_tmp );
+	BOOST_TEST( ~-4294967296_tmp == 4294967295_tmp );
+}
+
+BOOST_AUTO_TEST_CASE( tinymp_root )
+{
+	BOOST_TEST( isqrt(0_tmp) == 0 );
+	BOOST_TEST( isqrt(1_tmp) == 1 );
+	BOOST_TEST( isqrt(3_tmp) == 1 );
+	BOOST_TEST( isqrt(4_tmp) == 2 );
+	BOOST_TEST( isqrt(100000000000000000000000000000000000000000000_tmp) == 10000000000000000000000_tmp );
+	BOOST_TEST( isqrt(99999999999999999999999999999999999999999999_tmp) == 9999999999999999999999_tmp );
+	BOOST_TEST( iroot(1000000000000000000000000000000000000000000000000000000000000_tmp, 3) == 100000000000000000000_tmp );
+	BOOST_TEST( iroot(999999999999999999999999999999999999999999999999999999999999_tmp, 3) == 99999999999999999999_tmp );
+	BOOST_TEST( iroot(-1000000000000000000000000000000000000000000000000000000000000_tmp, 3) == -100000000000000000000_tmp );
+	BOOST_TEST( iroot(12345_tmp, 1) == 12345 );
+	BOOST_TEST( iroot(1_tmp << 1000, 10) == 1_tmp << 100 );
+	BOOST_CHECK_THROW( iroot(12345_tmp, 0), std::domain_error );
+
+	tinymp n = 1;
+	for(std::size_t i = 0; i < 300; ++i) {
+		n = n * 7 + 3;
+		auto sr = sqrtrem(n);
+		BOOST_TEST_CONTEXT( "i = " << i ) {
+			BOOST_TEST( sr.first * sr.first + sr.second == n );
+			BOOST_TEST( sr.second >= 0 );
+			BOOST_TEST( sr.second <= sr.first * 2 );
+			for(tinymp::value_type k = 2; k < 8; ++k) {
+				tinymp r = iroot(n, k), p = r, q = r + 1, pq = q;
+				for(tinymp::value_type j = 1; j < k; ++j) { p *= r; pq *= q; }
+				BOOST_TEST( p <= n );
+				BOOST_TEST( n < pq );
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( tinymp_perfect_power )
+{
+	BOOST_TEST( is_square(0_tmp) );
+	BOOST_TEST( is_square(1_tmp) );
+	BOOST_TEST( !is_square(2_tmp) );
+	BOOST_TEST( !is_square(-4_tmp) );
+	BOOST_TEST( is_perfect_power(0_tmp) );
+	BOOST_TEST( is_perfect_power(-1_tmp) );
+	BOOST_TEST( is_perfect_power(-8_tmp) );
+	BOOST_TEST( !is_perfect_power(-4_tmp) );
+	BOOST_TEST( !is_perfect_power(2_tmp) );
+	BOOST_TEST( is_perfect_power(1_tmp << 97) );
+	BOOST_TEST( !is_perfect_power(6_tmp << 96) );
+	BOOST_TEST( is_perfect_power(pow(12345_tmp, 97)) );
+	BOOST_TEST( is_perfect_power(-pow(3_tmp, 1009)) );
+	BOOST_TEST( !is_perfect_power(pow(3_tmp, 1009) + 2) );
+	BOOST_TEST( !is_perfect_power(pow(10_tmp, 3000) + 12347) ); // rejected by residues before any root
+	tinymp n = 3;
+	for(std::size_t i = 0; i < 200; ++i) {
+		n = n * 5 + 1;
+		BOOST_TEST_CONTEXT( "i = " << i ) {
+			tinymp sq = n * n;
+			BOOST_TEST( is_square(sq) );
+			BOOST_TEST( !is_square(sq + 1) );
+			BOOST_TEST( !is_square(sq - 1) );
+			BOOST_TEST( is_perfect_power(sq) );
+			BOOST_TEST( is_perfect_power(sq * n) );
+			BOOST_TEST( is_perfect_power(-(sq * n)) );
+			BOOST_TEST( is_perfect_power(sq * sq * n) );
+			BOOST_TEST( !is_perfect_power(sq * n + 1) );
+		}
+	}
+	std::size_t squares = 0, powers = 0;
+	for(tinymp::value_type i = 0; i <= 10000; ++i) {
+		squares += is_square(tinymp(i));
+		powers += is_perfect_power(tinymp(i));
+	}
+	BOOST_TEST( squares == 101 );
+	BOOST_TEST( powers == 126 ); // including 0 and 1
+}
+
+BOOST_AUTO_TEST_CASE( tinymp_prime )
+{
+	std::vector<bool> sieve(100000, true);
+	sieve[0] = sieve[1] = false;
+	for(std::size_t i = 2; i < sieve.size(); ++i)
+		if(sieve[i]) for(std::size_t j = i * i; j < sieve.size(); j += i) sieve[j] = false;
+	bool ok = true;
+	for(tinymp::value_type i = 0; i < sieve.size(); ++i) ok = ok && is_probable_prime(tinymp(i)) == sieve[i];
+	BOOST_TEST( ok );
+	BOOST_TEST( is_probable_prime(-7_tmp) );
+	BOOST_TEST( is_probable_prime(4294967291_tmp) );
+	BOOST_TEST( is_probable_prime(18446744073709551557_tmp) ); // largest prime below 2^64
+	BOOST_TEST( !is_probable_prime(18446744073709551559_tmp) );
+	BOOST_TEST( is_probable_prime(170141183460469231731687303715884105727_tmp) ); // 2^127 - 1
+	BOOST_TEST( !is_probable_prime(340282366920938463463374607431768211455_tmp) ); // 2^128 - 1
+	BOOST_TEST( is_probable_prime(359334085968622831041960188598043661065388726959079837_tmp, 5) );
+	BOOST_TEST( is_probable_prime(265252859812191058636308479999999_tmp) );
+	BOOST_TEST( is_probable_prime(8683317618811886495518194401279999999_tmp) );
+	BOOST_TEST( !is_probable_prime(265252859812191058636308479999999_tmp * 8683317618811886495518194401279999999_tmp) );
+	// strong pseudoprimes to base 2 and a Lucas pseudoprime
+	BOOST_TEST( !is_probable_prime(3215031751_tmp) );
+	BOOST_TEST( !is_probable_prime(2152302898747_tmp) );
+	BOOST_TEST( !is_probable_prime(3474749660383_tmp) );
+	BOOST_TEST( !is_probable_prime(341550071728321_tmp) );
+	BOOST_TEST( !is_probable_prime(3825123056546413051_tmp) );
+	BOOST_TEST( !is_probable_prime(318665857834031151167461_tmp) );
+	BOOST_TEST( !is_probable_prime(5459_tmp * 5459_tmp * 1000003_tmp) );
+	BOOST_TEST( !is_probable_prime(4294967291_tmp * 4294967291_tmp) );
+}
+
+BOOST_AUTO_TEST_CASE( tinymp_factor )
+{
+	BOOST_TEST( gcd(0_tmp, 0_tmp) == 0 );
+	BOOST_TEST( gcd(0_tmp, -12_tmp) == 12 );
+	BOOST_TEST( gcd(-12_tmp, 18_tmp) == 6 );
+	BOOST_TEST( gcd(11111111111111111111_tmp, 1111111111_tmp) == 1111111111 );
+	BOOST_TEST( gcd(3_tmp << 100, 9_tmp << 70) == 3_tmp << 70 );
+
+	BOOST_TEST( factor(0_tmp).empty() );
+	BOOST_TEST( factor(1_tmp).empty() );
+	std::vector<tinymp> expected = { 2, 2, 2, 3, 3, 257, 257 };
+	BOOST_TEST( factor(-8_tmp * 9 * 257 * 257) == expected, boost::test_tools::per_element() );
+	expected = { 1000003, 4294967291_tmp, 4294967291_tmp };
+	BOOST_TEST( factor(1000003_tmp * 4294967291_tmp * 4294967291_tmp) == expected, boost::test_tools::per_element() );
+	expected = { 1000000000039_tmp, 1000000000061_tmp, 18446744073709551557_tmp };
+	BOOST_TEST( factor(1000000000039_tmp * 1000000000061_tmp * 18446744073709551557_tmp) == expected, boost::test_tools::per_element() );
+	tinymp n = 1;
+	for(tinymp::value_type i = 2; i <= 30; ++i) n *= i;
+	auto f = factor(n + 1);
+	tinymp prod = 1;
+	for(auto &p : f) {
+		BOOST_TEST( is_probable_prime(p) );
+		prod *= p;
+	}
+	BOOST_TEST( prod == n + 1 );
+}
+
+BOOST_DATA_TEST_CASE( tinymp_divexact, bdata::make(vals) * bdata::make(vals), val1, val2 )
+{
+	if(val2 != 0) {
+		BOOST_TEST( divexact(val1 * val2, val2) == val1 );
+		BOOST_TEST( divexact((val1 * val2) << 37, val2 << 5) == val1 << 32 );
+		BOOST_TEST( divexact(val1 * val2 * 3_tmp, val2 * 3_tmp) == val1 );
+	}
+}
+
+BOOST_DATA_TEST_CASE( tinymp_mod, bdata::make(vals) * bdata::make(vals), val1, val2 )
+{
+	if(val2 != 0) {
+		auto qr = val1.div(val2);
+		BOOST_TEST( mod(val1, val2) == qr.second );
+		BOOST_TEST( val1 % val2 == qr.second );
+		BOOST_TEST( tinymp(val1) % val2 == qr.second );
+		tinymp t(val1);
+		BOOST_TEST( (t %= val2) == qr.second );
+		BOOST_TEST( val1.is_divisible_by(val2) == (qr.second == 0) );
+		BOOST_TEST( (val1 * val2).is_divisible_by(val2) );
+		BOOST_TEST( !((val1 * val2 << 1) + val2).is_divisible_by(val2 << 1) );
+	} else {
+		BOOST_TEST( val1.is_divisible_by(val2) == (val1 == 0) );
+	}
+	for(tinymp::value_type d : { 1u, 3u, 10u, 65535u, 65537u, 4294967291u, 4294967295u }) {
+		BOOST_TEST_CONTEXT( "d = " << d ) {
+			auto r = val1.div(d).second;
+			BOOST_TEST( val1.mod_ui(d) == (r < 0 ? -r : r) );
+			BOOST_TEST( val1 % d == r );
+			BOOST_TEST( val1.is_divisible_by(d) == (r == 0) );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( tinymp_divexact_misc )
+{
+	BOOST_TEST( divexact(factorial(300), factorial(200)) == factorial(300) / factorial(200) );
+	BOOST_TEST( divexact(factorial(300) * 4294967291_tmp, 4294967291_tmp * 255255) == factorial(300) / 255255 );
+	BOOST_TEST( divexact(-(pow(7_tmp, 500) << 64), pow(7_tmp, 123) << 3) == -(pow(7_tmp, 377) << 61) );
+	BOOST_TEST( divexact(4294967295_tmp * 4294967295_tmp, 4294967295_tmp) == 4294967295_tmp );
+}
+
+BOOST_AUTO_TEST_CASE( tinymp_mul_parallel )
+{
+	tinymp a = pow(3_tmp, 30000) - 1, b = pow(7_tmp, 5000) + 1;
+	auto expected = a * b;
+	for(unsigned threads : { 0u, 1u, 2u, 3u, 4u, 7u, 64u }) {
+		BOOST_TEST_CONTEXT( "threads = " << threads ) {
+			BOOST_TEST( mul_parallel(a, b, threads) == expected );
+			BOOST_TEST( mul_parallel(b, a, threads) == expected );
+			BOOST_TEST( mul_parallel(-a, b, threads) == -expected );
+			BOOST_TEST( mul_parallel(-a, -b, threads) == expected );
+		}
+	}
+	BOOST_TEST( mul_parallel(a, a) == a * a );
+	BOOST_TEST( mul_parallel(a, 0_tmp) == 0 );
+	BOOST_TEST( mul_parallel(a << 40000, b, 4) == expected << 40000 );
+	BOOST_TEST( mul_parallel(1_tmp << 100000, -1_tmp << 100000, 4) == -1_tmp << 200000 );
+}
+
+BOOST_AUTO_TEST_CASE( tinymp_parallel_batch )
+{
+	std::vector<tinymp> vals;
+	for(tinymp::value_type i = 1; i <= 1000; ++i) vals.push_back(i % 3 ? pow(tinymp(i), i % 50) : -pow(tinymp(i), 7));
+	tinymp sum = 0, product = 1;
+	for(auto &val : vals) {
+		sum += val;
+		product *= val;
+	}
+	for(unsigned threads : { 0u, 1u, 2u, 5u, 8u }) {
+		BOOST_TEST_CONTEXT( "threads = " << threads ) {
+			BOOST_TEST( parallel_sum(vals, threads) == sum );
+			BOOST_TEST( parallel_product(vals, threads) == product );
+			auto squares = parallel_transform(vals, [](const tinymp &val) { return val * val; }, threads);
+			auto residues = parallel_mod(vals, 1000000007_tmp, threads);
+			BOOST_TEST( squares.size() == vals.size() );
+			BOOST_TEST( residues.size() == vals.size() );
+			for(std::size_t i = 0; i < vals.size(); ++i) {
+				BOOST_TEST( squares[i] == vals[i] * vals[i] );
+				BOOST_TEST( residues[i] == vals[i] % 1000000007_tmp );
+			}
+		}
+	}
+	for(std::size_t bad : { std::size_t(0), std::size_t(999) }) { // in the calling thread and in a worker
+		BOOST_CHECK_THROW( parallel_transform(vals, [&](const tinymp &val) {
+			if(&val == &vals[bad]) throw std::runtime_error("bad value");
+			return val;
+		}, 4), std::runtime_error );
+	}
+	std::vector<tinymp> empty;
+	BOOST_TEST( parallel_sum(empty) == 0 );
+	BOOST_TEST( parallel_product(empty) == 1 );
+	BOOST_TEST( parallel_transform(empty, [](const tinymp &val) { return val; }).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( tinymp_thread_safety )
+{
+	// each thread works on its own objects and reads shared ones, results must match a serial run
+	const tinymp shared = pow(3_tmp, 2000) + 12345;
+	const auto work = [&shared](unsigned seed) {
+		tinymp acc = seed, t = shared;
+		for(unsigned i = 0; i < 100; ++i) {
+			acc += shared;
+			acc *= seed + i + 1;
+			acc -= shared >> (i % 64);
+			t = acc % shared;
+			acc = (acc / (i + 2)) ^ t;
+			if(acc.is_divisible_by(3)) acc = divexact(acc, 3_tmp);
+#ifdef TINYMP_KARATSUBA
+			acc += acc.mult(shared) >> 3000;
+#endif
+			acc %= shared << 64;
+			acc = tinymp::stotmp(to_string(acc));
+		}
+		return acc;
+	};
+	const unsigned threads = 8;
+	std::vector<tinymp> expected(threads), actual(threads);
+	for(unsigned i = 0; i < threads; ++i) expected[i] = work(i);
+	std::vector<std::thread> workers;
+	for(unsigned i = 0; i < threads; ++i) workers.emplace_back([&, i]{ actual[i] = work(i); });
+	for(auto &w : workers) w.join();
+	BOOST_TEST( actual == expected, boost::test_tools::per_element() );
+}
+
+BOOST_AUTO_TEST_CASE( tinymp_pow )
+{
+	for(int b = -20; b <= 20; ++b) {
+		tinymp base(std::abs(b), b >= 0), expected = 1;
+		for(std::uint64_t e = 0; e <= 70; ++e) {
+			BOOST_TEST_CONTEXT( "b = " << b << " e = " << e ) {
+				BOOST_TEST( pow(base, e) == expected );
+			}
+			expected *= base;
+		}
+	}
+	BOOST_TEST( pow(tinymp(2), 1000) == (tinymp(1) << 1000) );
+	BOOST_TEST( pow(tinymp(2, false), 1001) == -(tinymp(1) << 1001) );
+	BOOST_TEST( pow(tinymp(1, false), std::uint64_t(-1)) == tinymp(1, false) );
+	BOOST_TEST( pow(tinymp(1, false), std::uint64_t(-2)) == 1 );
+	BOOST_TEST( pow(tinymp(0), 0) == 1 );
+	BOOST_TEST( pow(10_tmp, 30) == 1000000000000000000000000000000_tmp );
+	BOOST_TEST( pow(pow(tinymp(12345), 7), 3) == pow(tinymp(12345), 21) );
+}
+
+BOOST_AUTO_TEST_CASE( tinymp_product )
+{
+	std::vector<tinymp> vals;
+	for(tinymp::value_type i = 1; i <= 500; ++i) vals.push_back(i % 7 ? tinymp(i * 2654435761u) : pow(tinymp(i, false), i % 40));
+	auto expected = std::accumulate(vals.begin(), vals.end(), tinymp(1), std::multiplies<tinymp>());
+	BOOST_TEST( tinymp::product(vals.begin(), vals.end()) == expected );
+	BOOST_TEST( tinymp::product(vals.begin(), vals.begin() + 1) == vals[0] );
+	BOOST_TEST( tinymp::product(vals.begin(), vals.begin()) == 1 );
+	vals[250] = 0;
+	BOOST_TEST( tinymp::product(vals.begin(), vals.end()) == 0 );
+	std::vector<tinymp::value_type> small(100);
+	std::iota(small.begin(), small.end(), 1);
+	BOOST_TEST( tinymp::product(small.begin(), small.end()) == factorial(100) );
+}
+
+BOOST_DATA_TEST_CASE( tinymp_serialize, bdata::make(vals), val )
+{
+	auto s = val.serialize();
+	BOOST_TEST( s.size() == val.serialized_size() );
+	tinymp t = 12345;
+	BOOST_TEST( t.deserialize(s.data(), s.data() + s.size()) == s.data() + s.size() );
+	BOOST_TEST( t == val );
+	if(s.size() > 1) {
+		BOOST_TEST( !t.deserialize(s.data(), s.data() + s.size() - 1) );
+	}
+	std::stringstream ss;
+	val.serialize(ss);
+	(val * val).serialize(ss);
+	BOOST_TEST( ss.str().substr(0, s.size()) == s );
+	tinymp t1, t2, t3;
+	BOOST_TEST( static_cast<bool>(t1.deserialize(ss)) );
+	BOOST_TEST( static_cast<bool>(t2.deserialize(ss)) );
+	BOOST_TEST( !t3.deserialize(ss) );
+	BOOST_TEST( t1 == val );
+	BOOST_TEST( t2 == val * val );
+}
+
+BOOST_AUTO_TEST_CASE( tinymp_serialize_format )
+{
+	BOOST_TEST( (0_tmp).serialize() == std::string(1, '\0') );
+	BOOST_TEST( (1_tmp).serialize() == std::string("\x02\x01\0\0\0", 5) );
+	BOOST_TEST( (-0x123456789_tmp).serialize() == std::string("\x05\x89\x67\x45\x23\x01\0\0\0", 9) );
+	auto big = (1_tmp << (32 * 100)) - 1; // 100 limbs, the header takes 2 bytes
+	auto s = big.serialize();
+	BOOST_TEST( s.size() == 2 + 400 );
+	BOOST_TEST( s.substr(0, 2) == std::string("\xC8\x01", 2) );
+	tinymp t;
+	BOOST_TEST( t.deserialize(s.data(), s.data() + s.size()) == s.data() + s.size() );
+	BOOST_TEST( t == big );
+	std::istringstream iss(s.substr(0, 100));
+	BOOST_TEST( !t.deserialize(iss) );
+	BOOST_TEST( t == 0 );
+}
+
+BOOST_AUTO_TEST_CASE( tinymp_serialize_malformed )
+{
+	tinymp t = 7;
+	const std::string overlong(11, '\x80');
+	BOOST_TEST( t.deserialize(overlong.data(), overlong.data() + overlong.size()) == nullptr );
+	BOOST_TEST( t == 7 );
+	const std::string top_bits = std::string(9, '\xFF') + '\x02'; // 65 bits
+	BOOST_TEST( t.deserialize(top_bits.data(), top_bits.data() + top_bits.size()) == nullptr );
+	const std::string zero_top("\x04\x01\0\0\0\0\0\0\0", 9); // two limbs, the top one zero
+	BOOST_TEST( t.deserialize(zero_top.data(), zero_top.data() + zero_top.size()) == nullptr );
+	BOOST_TEST( t == 7 );
+	for(const auto &bad : { std::string("\x01"), std::string("\x80\x00", 2), std::string("\x82\x00\x01\0\0\0", 6) }) { // negative zero, overlong headers
+		BOOST_TEST( t.deserialize(bad.data(), bad.data() + bad.size()) == nullptr );
+		BOOST_TEST( t == 7 );
+		std::istringstream iss(bad);
+		BOOST_TEST( !t.deserialize(iss) );
+		BOOST_TEST( t == 0 );
+		t = 7;
+	}
+	std::istringstream iss1(overlong);
+	BOOST_TEST( !t.deserialize(iss1) );
+	BOOST_TEST( t == 0 );
+	t = 7;
+	std::istringstream iss2(zero_top);
+	BOOST_TEST( !t.deserialize(iss2) );
+	BOOST_TEST( t == 0 );
+	t = 7;
+	std::istringstream iss3(std::string("\xFE\xFF\xFF\xFF\xFF\xFF\xFF\x7F\x01\0\0\0", 12)); // a huge count with a single limb behind it
+	BOOST_TEST( !t.deserialize(iss3) );
+	BOOST_TEST( t == 0 );
+}
+
+BOOST_DATA_TEST_CASE( tinymp_view_ops, bdata::make(vals) * bdata::make(vals), val1, val2 )
+{
+	tinymp_view v1(val1), v2(val2);
+	BOOST_TEST( (v1 == v2) == (val1 == val2) );
+	BOOST_TEST( (v1 != v2) == (val1 != val2) );
+	BOOST_TEST( (v1 < v2) == (val1 < val2) );
+	BOOST_TEST( (v1 >= val2) == (val1 >= val2) );
+	BOOST_TEST( (val1 <= v2) == (val1 <= val2) );
+	BOOST_TEST( v1.hash() == val1.hash() );
+	BOOST_TEST( tinymp(v1) == val1 );
+	BOOST_TEST( v1 + v2 == val1 + val2 );
+	BOOST_TEST( v1 - v2 == val1 - val2 );
+	BOOST_TEST( v1 * v2 == val1 * val2 );
+	tinymp t(val1);
+	BOOST_TEST( (t += v2) == val1 + val2 );
+	BOOST_TEST( (t -= v2) == val1 );
+	BOOST_TEST( (t *= v2) == val1 * val2 );
+	t = val1;
+	BOOST_TEST( (t *= tinymp_view(t)) == val1 * val1 );
+}
+
+BOOST_AUTO_TEST_CASE( tinymp_view_misc )
+{
+	const tinymp::value_type limbs[] = { 0xFFFFFFFFu, 0x12345678u, 0u, 0u };
+	tinymp_view v(limbs, 4, false); // leading zero limbs are ignored
+	BOOST_TEST( v.size() == 2 );
+	BOOST_TEST( v == -0x12345678FFFFFFFF_tmp );
+	BOOST_TEST( std::hash<tinymp_view>()(v) == std::hash<tinymp>()(-0x12345678FFFFFFFF_tmp) );
+	BOOST_TEST( tinymp_view(limbs + 2, 2, false) == 0_tmp );
+	BOOST_TEST( tinymp_view(limbs + 2, 2, false).is_nonneg() );
+	BOOST_TEST( v.slice(1, 2) == 0x12345678_tmp );
+	BOOST_TEST( v.slice(0, 1) == 0xFFFFFFFF_tmp );
+	BOOST_TEST( v.slice(2, 5).is_zero() );
+	BOOST_TEST( v.slice(3, 1).is_zero() );
+	tinymp t = 1_tmp << 100;
+	t += v;
+	BOOST_TEST( t == (1_tmp << 100) - 0x12345678FFFFFFFF_tmp );
+	std::ostringstream oss;
+	oss << v;
+	BOOST_TEST( oss.str() == "-1311768469162688511" );
+}
+
+BOOST_AUTO_TEST_CASE( tinymp_combinatorial )
+{
+	tinymp f = 1;
+	for(tinymp::value_type n = 0; n <= 300; ++n) {
+		if(n > 0) f *= n;
+		BOOST_TEST_CONTEXT( "n = " << n ) {
+			BOOST_TEST( factorial(n) == f );
+		}
+	}
+	std::vector<tinymp> row(1, 1);
+	for(tinymp::value_type n = 0; n <= 100; ++n) {
+		for(tinymp::value_type k = 0; k <= n; ++k) {
+			BOOST_TEST_CONTEXT( "n = " << n << " k = " << k ) {
+				BOOST_TEST( binomial(n, k) == row[k] );
+			}
+		}
+		BOOST_TEST( binomial(n, n + 1) == 0 );
+		row.push_back(1);
+		for(auto k = n; k > 0; --k) row[k] += row[k - 1];
+	}
+	BOOST_TEST( factorial(1000) / factorial(990) / factorial(10) == binomial(1000, 10) );
+	BOOST_TEST( primorial(0) == 1 );
+	BOOST_TEST( primorial(1) == 1 );
+	BOOST_TEST( primorial(2) == 2 );
+	BOOST_TEST( primorial(30) == 6469693230_tmp );
+	BOOST_TEST( primorial(100) == 2305567963945518424753102147331756070_tmp );
+}
+
 BOOST_DATA_TEST_CASE( tinymp_comparison, bdata::make(vals), val0 )
 {
 	tinymp val1 = val0 + 1;
@@ -268,6 +851,61 @@ BOOST_DATA_TEST_CASE( tinymp_comparison, bdata::make(vals), val0 )
 	BOOST_TEST( !(val0 >= val1 ) );
 }
 
+BOOST_DATA_TEST_CASE( tinymp_fixed_arith, bdata::make(vals) * bdata::make(vals), val1, val2 )
+{
+	typedef tinymp_fixed<256> fixed;
+	const tinymp modulo = tinymp(1) << 256;
+	auto wrap = [&](const tinymp &t) { tinymp r = t % modulo; if(r >= (modulo >> 1)) r -= modulo; if(r < -(modulo >> 1)) r += modulo; return r; };
+	fixed f1(val1), f2(val2);
+	BOOST_TEST( tinymp(f1) == val1 );
+	BOOST_TEST( tinymp(f1 + f2) == val1 + val2 );
+	BOOST_TEST( tinymp(f1 - f2) == val1 - val2 );
+	BOOST_TEST( tinymp(f1 * f2) == wrap(val1 * val2) );
+	BOOST_TEST( tinymp(f1 * 0xFFFFFFFFu) == val1 * 0xFFFFFFFFu );
+	BOOST_TEST( tinymp(f1 * f2 * f2 * f2) == wrap(val1 * val2 * val2 * val2) );
+	BOOST_TEST( tinymp(-f1) == -val1 );
+	BOOST_TEST( tinymp(f1 << 100) == wrap(val1 << 100) );
+	BOOST_TEST( (f1 <  f2) == (val1 <  val2) );
+	BOOST_TEST( (f1 <= f2) == (val1 <= val2) );
+	BOOST_TEST( (f1 >  f2) == (val1 >  val2) );
+	BOOST_TEST( (f1 >= f2) == (val1 >= val2) );
+	BOOST_TEST( (f1 == f2) == (val1 == val2) );
+	BOOST_TEST( (f1 != f2) == (val1 != val2) );
+	if(val1 >= 0) BOOST_TEST( tinymp(f1 >> 33) == val1 >> 33 );
+	if(val2 != 0) {
+		BOOST_TEST( tinymp(f1 / f2) == val1 / val2 );
+		BOOST_TEST( tinymp(f1 % f2) == val1 % val2 );
+		BOOST_TEST( tinymp(f1 * f1 / f2) == val1 * val1 / val2 );
+		BOOST_TEST( tinymp(f1 * f1 % f2) == val1 * val1 % val2 );
+	}
+	BOOST_TEST( std::hash<fixed>{}(f1) == std::hash<fixed>{}(fixed(val1)) );
+}
+
+BOOST_AUTO_TEST_CASE( tinymp_fixed_misc )
+{
+	typedef tinymp_fixed<128> fixed;
+	fixed t(1);
+	BOOST_TEST( tinymp(t << 127) == -(1_tmp << 127) ); // wrap around
+	BOOST_TEST( tinymp((t << 127) - 1) == (1_tmp << 127) - 1 );
+	BOOST_TEST( (fixed(1, false) >> 1) == fixed(1, false) ); // arithmetic shift
+	BOOST_TEST( (fixed(5, false) >> 1) == fixed(3, false) );
+	BOOST_TEST( to_string(fixed(12345, false)) == "-12345" );
+	BOOST_TEST( ++t == 2 );
+	BOOST_TEST( t-- == 2 );
+	BOOST_TEST( t == 1 );
+	std::istringstream iss("-340282366920938463463374607431768211455");
+	iss >> t;
+	BOOST_TEST( t == 1 ); // -(2^128 - 1) wraps to 1
+	std::ostringstream oss;
+	oss << fixed(255, false);
+	BOOST_TEST( oss.str() == "-255" );
+#if __cplusplus >= 201703L
+	constexpr fixed c = fixed(0xFFFFFFFFu) * fixed(0xFFFFFFFFu) + 1;
+	static_assert(c == (fixed(0xFFFFFFFEu) << 32) + 2, "constexpr arithmetic");
+	static_assert(c / fixed(0xFFFFFFFFu) == fixed(0xFFFFFFFFu), "constexpr division");
+#endif
+}
+
 tinymp in(const std::string& s, std::ios_base::fmtflags base = std::ios_base::dec)
 {
 	tinymp t;
@@ -367,6 +1005,89 @@ BOOST_AUTO_TEST_CASE( tinymp_io )
 	BOOST_TEST( std::string("ffffffff000000000000000000000000") == to_string(340282366841710300949110269838224261120_tmp, 16) );
 }
 
+BOOST_DATA_TEST_CASE( tinymp_to_chars, bdata::make(vals), val )
+{
+	for(int base : { 2, 8, 10, 16, 36 }) {
+		BOOST_TEST_CONTEXT( "base = " << base ) {
+			auto s = to_string(val, base);
+			BOOST_TEST( s.size() <= val.chars_bound(base) );
+			BOOST_TEST( stotmp(s, base) == val );
+			char buf[128];
+			auto p = to_chars(buf, buf + sizeof(buf), val, base);
+			BOOST_TEST( std::string(buf, p) == s );
+			BOOST_TEST( to_chars(buf, buf + s.size(), val, base) == buf + s.size() );
+			BOOST_TEST( !to_chars(buf, buf + s.size() - 1, val, base) );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( tinymp_to_chars_misc )
+{
+	BOOST_TEST( to_string(0_tmp) == "0" );
+	BOOST_TEST( to_string(1000000000_tmp) == "1000000000" );
+	BOOST_TEST( to_string(-(1_tmp << 64), 16) == "-10000000000000000" );
+	BOOST_TEST( to_string(255_tmp, 16, true) == "FF" );
+	auto big = pow(10_tmp, 5000);
+	auto s = to_string(big);
+	BOOST_TEST( s.size() == 5001 );
+	BOOST_TEST( s == "1" + std::string(5000, '0') );
+	BOOST_TEST( big.chars_bound() - s.size() <= 2 );
+	std::ostringstream oss;
+	oss << -big << ' ' << std::hex << std::uppercase << 3054_tmp;
+	BOOST_TEST( oss.str() == "-" + s + " BEE" );
+	std::ostringstream padded;
+	padded << std::setw(8) << 255_tmp << '|' << std::setw(6) << -42_tmp << 7 << '|';
+	padded << std::left << std::setw(6) << -42_tmp << '|' << std::internal << std::setfill('0') << std::setw(6) << -42_tmp << '|' << std::setw(2) << 12345_tmp;
+	BOOST_TEST( padded.str() == "     255|   -427|-42   |-00042|12345" );
+}
+
+BOOST_AUTO_TEST_CASE( tinymp_io_stream )
+{
+	std::istringstream iss("  123456789012345678901234567890\n-42 0 -0 7x 99");
+	tinymp t = 1_tmp << 1000; // limbs are reused
+	BOOST_TEST( static_cast<bool>(iss >> t) );
+	BOOST_TEST( t == 123456789012345678901234567890_tmp );
+	BOOST_TEST( static_cast<bool>(iss >> t) );
+	BOOST_TEST( t == -42_tmp );
+	BOOST_TEST( static_cast<bool>(iss >> t) );
+	BOOST_TEST( t == 0 );
+	BOOST_TEST( static_cast<bool>(iss >> t) );
+	BOOST_TEST( t == 0 );
+	BOOST_TEST( to_string(t) == "0" );
+	BOOST_TEST( static_cast<bool>(iss >> t) ); // stops before 'x'
+	BOOST_TEST( t == 7 );
+	char c;
+	iss >> c;
+	BOOST_TEST( c == 'x' );
+	BOOST_TEST( static_cast<bool>(iss >> t) );
+	BOOST_TEST( t == 99 );
+	BOOST_TEST( iss.eof() );
+	BOOST_TEST( !(iss >> t) );
+
+	std::istringstream bad("-x");
+	BOOST_TEST( !(bad >> t) );
+	std::istringstream bad_plus("+-1");
+	BOOST_TEST( !(bad_plus >> t) );
+	BOOST_TEST( in("+12") == 12 );
+	BOOST_TEST( in("+0") == 0 );
+	BOOST_TEST( in("+ff", std::ios_base::hex) == 255 );
+	BOOST_TEST( in("777", std::ios_base::oct) == 511 );
+	BOOST_TEST( in("778", std::ios_base::oct) == 63 );
+	BOOST_TEST( in("fFfFfFfFfFfFfFfF", std::ios_base::hex) == 18446744073709551615_tmp );
+	std::string digits(1000, '9');
+	BOOST_TEST( in(digits) == pow(10_tmp, 1000) - 1 );
+	BOOST_TEST( in("-" + digits) == 1 - pow(10_tmp, 1000) );
+
+	std::istringstream many("1 -2 3\n4294967296 5");
+	std::vector<tinymp> vals(4);
+	BOOST_TEST( static_cast<bool>(read_many(many, vals)) );
+	std::vector<tinymp> expected = { 1, -2_tmp, 3, 4294967296_tmp };
+	BOOST_TEST( vals == expected, boost::test_tools::per_element() );
+	vals.resize(2);
+	BOOST_TEST( !read_many(many, vals) );
+	BOOST_TEST( vals[0] == 5 );
+}
+
 // std::is_swappable and std::is_nothrow_swappable are available only from C++17
 namespace {
     using std::swap;
@@ -420,13 +1141,44 @@ BOOST_AUTO_TEST_CASE( tinymp_stdif )
 	BOOST_TEST( hmap.count(1000000_tmp) == 0 );
 }
 
+BOOST_DATA_TEST_CASE( tinymp_hash, bdata::make(vals) * bdata::make(vals), val1, val2 )
+{
+	auto hasher = std::hash<tinymp>{};
+	tinymp t(val1);
+	t += val2;
+	t -= val2;
+	BOOST_TEST( hasher(t) == hasher(val1) );
+	if(val1 != val2) BOOST_TEST( hasher(val1) != hasher(val2) );
+
+	tinymp_hashed h1(val1), h2(val2);
+	BOOST_TEST( (h1 == h2) == (val1 == val2) );
+	BOOST_TEST( h1.hash() == hasher(val1) );
+	h1.modify_([&](tinymp &v) { v *= val2; });
+	BOOST_TEST( h1.get() == val1 * val2 );
+	BOOST_TEST( h1.hash() == hasher(val1 * val2) );
+	h2 = val1;
+	BOOST_TEST( h2.hash() == hasher(val1) );
+}
+
+BOOST_AUTO_TEST_CASE( tinymp_hashed_map )
+{
+	std::unordered_map<tinymp_hashed, int> hmap;
+	tinymp t = 1;
+	for(int i = 0; i < 100; ++i, t *= 3) hmap[t] = i;
+	t = 1;
+	for(int i = 0; i < 100; ++i, t *= 3) {
+		BOOST_TEST( hmap.count(t) == 1 );
+		BOOST_TEST( hmap[t] == i );
+		BOOST_TEST( hmap.count(t + 1) == 0 );
+	}
+}
+
 BOOST_AUTO_TEST_CASE( tinymp_time, *boost::unit_test::disabled() )
 {
 	BOOST_TEST_MESSAGE( "[multiplication for same size]" );
 	for(std::size_t i = 400; i <= 10000; i+= 400) {
 		std::ostringstream oss;
-		tinymp t1(1);
-		for(std::size_t j = 0; j < i; ++j) t1 *= 10;
+		tinymp t1 = pow(tinymp(10), i);
 		tinymp t2(t1);
 		{
 			boost::timer::auto_cpu_timer t(oss, "%w");
@@ -440,8 +1192,7 @@ BOOST_AUTO_TEST_CASE( tinymp_time, *boost::unit_test::disabled() )
 	BOOST_TEST_MESSAGE( "[multiplication by Karatsuba for same size]" );
 	for(std::size_t i = 400; i <= 10000; i+= 400) {
 		std::ostringstream oss;
-		tinymp t1(1);
-		for(std::size_t j = 0; j < i; ++j) t1 *= 10;
+		tinymp t1 = pow(tinymp(10), i);
 		tinymp t2(t1);
 		{
 			boost::timer::auto_cpu_timer t(oss, "%w");